@@ -0,0 +1,224 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+#include "ShamsQueueStats.hpp"
+
+namespace SHAMS
+{
+    /**
+     * @brief Single-producer ring buffer that delivers every item to every consumer
+     *
+     * Each item is stored once. Every consumer reads it through its own cursor, so fanning one
+     * stream out to several readers needs neither a ring per reader nor a copy per reader. The
+     * producer only reuses a slot once the slowest cursor has moved past it, so backpressure
+     * follows the slowest consumer.
+     *
+     * The number of consumers is fixed at construction and each one is addressed by its index.
+     * Every consumer index must be read from at most one thread at a time.
+     *
+     * @note Lock-free, exactly one thread may push.
+     *
+     * @tparam T - The item type
+     * @tparam StatsPolicy - QueueStatsCounters to collect traffic counters for stats(), NoQueueStats to compile them out
+     */
+    template <typename T, typename StatsPolicy = NoQueueStats>
+    class BroadcastRingBuffer
+    {
+    public:
+        /**
+         * @brief Constructs the buffer
+         *
+         * @param capacity - The number of slots, rounded up to a power of two
+         * @param consumers - The number of consumers that read every item
+         * @throws std::invalid_argument - If capacity or consumers is zero
+         */
+        BroadcastRingBuffer(uint32_t capacity, uint32_t consumers)
+            : m_capacity(std::bit_ceil(capacity)),
+              m_consumerCount(consumers),
+              m_buffer(std::make_unique<T[]>(m_capacity)),
+              m_cursors(std::make_unique<Cursor[]>(consumers))
+        {
+            if (capacity == 0 or consumers == 0)
+            {
+                throw std::invalid_argument("Capacity and consumer count must be greater than zero");
+            }
+        }
+
+        /**
+         * @brief Publishes an item to every consumer, producer thread only
+         *
+         * @param item - The item to publish
+         * @return bool - True if the item was published, false if the slowest consumer is a full buffer behind
+         */
+        bool push(const T &item)
+        {
+            const uint32_t published = m_producer.published.load(std::memory_order_relaxed);
+            if (published - m_producer.cachedSlowest == m_capacity)
+            {
+                m_producer.cachedSlowest = this->slowestCursor();
+                if (published - m_producer.cachedSlowest == m_capacity)
+                {
+                    m_stats.recordRejectedPush();
+                    return false;
+                }
+            }
+            m_buffer[published & (m_capacity - 1)] = item;
+            m_producer.published.store(published + 1, std::memory_order_release);
+            m_stats.recordPush(1, published + 1 - m_producer.cachedSlowest);
+            return true;
+        }
+
+        /**
+         * @brief Returns the next unread item of a consumer without consuming it
+         *
+         * The item is read in place and stays valid until the consumer calls release().
+         *
+         * @param consumer - The consumer index
+         * @return const T* - The next item, nullptr if the consumer has read everything published
+         */
+        const T *peek(uint32_t consumer)
+        {
+            Cursor &cursor = this->cursorFor(consumer);
+            const uint32_t next = cursor.next.load(std::memory_order_relaxed);
+            if (next == cursor.cachedPublished)
+            {
+                cursor.cachedPublished = m_producer.published.load(std::memory_order_acquire);
+                if (next == cursor.cachedPublished)
+                {
+                    m_stats.recordFailedPop();
+                    return nullptr;
+                }
+            }
+            return &m_buffer[next & (m_capacity - 1)];
+        }
+
+        /**
+         * @brief Moves a consumer past the item returned by peek(), letting the producer reuse its slot
+         *
+         * @param consumer - The consumer index
+         * @throws std::out_of_range - If the consumer has no published item to move past
+         */
+        void release(uint32_t consumer)
+        {
+            Cursor &cursor = this->cursorFor(consumer);
+            const uint32_t next = cursor.next.load(std::memory_order_relaxed);
+            // peek() refreshes cachedPublished before returning an item, so an equal value means there is none
+            if (next == cursor.cachedPublished)
+            {
+                throw std::out_of_range("Release without a peeked item");
+            }
+            cursor.next.store(next + 1, std::memory_order_release);
+            m_stats.recordPop(1);
+        }
+
+        /**
+         * @brief Copies out the next unread item of a consumer and moves past it
+         *
+         * @param consumer - The consumer index
+         * @param item - Receives the item
+         * @return bool - True if an item was read, false if the consumer has read everything published
+         */
+        bool pop(uint32_t consumer, T &item)
+        {
+            const T *next = this->peek(consumer);
+            if (next == nullptr)
+            {
+                return false;
+            }
+            item = *next;
+            this->release(consumer);
+            return true;
+        }
+
+        /**
+         * @brief Returns the number of published items a consumer has not read yet
+         *
+         * @param consumer - The consumer index
+         * @return uint32_t - The number of unread items
+         */
+        uint32_t size(uint32_t consumer) const
+        {
+            const uint32_t next = this->cursorFor(consumer).next.load(std::memory_order_acquire);
+            return m_producer.published.load(std::memory_order_acquire) - next;
+        }
+
+        uint32_t capacity() const
+        {
+            return m_capacity;
+        }
+
+        uint32_t consumers() const
+        {
+            return m_consumerCount;
+        }
+
+        /**
+         * @brief Returns a snapshot of the traffic counters, all zero unless StatsPolicy is QueueStatsCounters
+         *
+         * Pops and failed pops are summed over all consumers, so once everything has been read
+         * pops is pushes times the consumer count. peakSize counts the slots the producer
+         * last saw held by the slowest consumer.
+         *
+         * @return QueueStats - The counters since construction, contendedLocks is always zero
+         */
+        QueueStats stats() const
+        {
+            return m_stats.snapshot();
+        }
+
+    private:
+        static constexpr size_t k_cacheLineSize = 64;
+
+        // Sequence numbers run freely and wrap at 2^32, a multiple of the power-of-two capacity
+        struct alignas(k_cacheLineSize) Cursor
+        {
+            std::atomic<uint32_t> next = 0;
+            uint32_t cachedPublished = 0;
+        };
+
+        struct alignas(k_cacheLineSize) Producer
+        {
+            std::atomic<uint32_t> published = 0;
+            uint32_t cachedSlowest = 0;
+        };
+
+        Cursor &cursorFor(uint32_t consumer) const
+        {
+            if (consumer >= m_consumerCount)
+            {
+                throw std::out_of_range("Consumer index out of range");
+            }
+            return m_cursors[consumer];
+        }
+
+        uint32_t slowestCursor() const
+        {
+            const uint32_t published = m_producer.published.load(std::memory_order_relaxed);
+            uint32_t slowest = published;
+            for (uint32_t i = 0; i < m_consumerCount; i++)
+            {
+                const uint32_t next = m_cursors[i].next.load(std::memory_order_acquire);
+                // Compare by distance behind the producer so the wrap at 2^32 is handled
+                if (published - next > published - slowest)
+                {
+                    slowest = next;
+                }
+            }
+            return slowest;
+        }
+
+    private:
+        const uint32_t m_capacity;
+        const uint32_t m_consumerCount;
+        std::unique_ptr<T[]> m_buffer;
+        std::unique_ptr<Cursor[]> m_cursors;
+        Producer m_producer;
+        [[no_unique_address]] StatsPolicy m_stats;
+    };
+
+} // namespace SHAMS
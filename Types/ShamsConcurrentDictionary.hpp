@@ -0,0 +1,133 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "ShamsDictionary.hpp"
+#include "ShamsHashing.hpp"
+
+namespace SHAMS
+{
+    /**
+     * @brief Dictionary split into independently locked shards for many concurrent writers
+     *
+     * Every key belongs to one shard picked from its hash, and each shard is a Dictionary with
+     * its own lock and its own slots. Threads working on keys in different shards never wait
+     * for each other, so throughput scales with the thread count instead of serialising on a
+     * single lock. Shards are allocated separately and cache-line aligned, so their locks do
+     * not share a cache line either.
+     *
+     * Each shard has a fixed capacity. A skewed key set can fill one shard, after which inserts
+     * into that shard return false while the others still have room.
+     *
+     * @tparam key_type - The key type
+     * @tparam value_type - The value type
+     * @tparam t_shards - The number of shards, a few times the number of writer threads works well
+     * @tparam LockPolicy - The lock of each shard, std::mutex or SpinLock
+     * @tparam Hash - The hash function for key_type
+     */
+    template <typename key_type, typename value_type, uint32_t t_shards = 16, typename LockPolicy = std::mutex, typename Hash = KeyHash<key_type>>
+    class ConcurrentDictionary
+    {
+        static_assert(t_shards > 0, "ConcurrentDictionary needs at least one shard");
+
+    public:
+        /**
+         * @brief Constructs the dictionary
+         *
+         * @param shardCapacity - The number of entries each shard can hold, the total is t_shards times this
+         */
+        ConcurrentDictionary(uint32_t shardCapacity)
+        {
+            for (std::unique_ptr<Shard> &shard : m_shards)
+            {
+                shard = std::make_unique<Shard>(shardCapacity);
+            }
+        }
+
+        bool insert(const key_type &key, const value_type &value)
+        {
+            return this->shardFor(key).insert(key, value);
+        }
+
+        bool remove(const key_type &key)
+        {
+            return this->shardFor(key).remove(key);
+        }
+
+        bool contains(const key_type &key) const
+        {
+            return this->shardFor(key).contains(key);
+        }
+
+        /**
+         * @brief Returns the value stored for a key
+         *
+         * @note The reference is not protected by the shard's lock once this returns.
+         *
+         * @param key - The key to look up
+         * @throws std::out_of_range - If the key is not in the dictionary
+         * @return value_type& - The stored value
+         */
+        value_type &operator[](const key_type &key)
+        {
+            return this->shardFor(key)[key];
+        }
+
+        /**
+         * @brief Returns the number of entries, summed shard by shard
+         *
+         * Shards are counted one after another, so with concurrent writers the total is not a
+         * single consistent snapshot.
+         *
+         * @return uint32_t - The number of entries
+         */
+        uint32_t size() const
+        {
+            uint32_t total = 0;
+            for (const std::unique_ptr<Shard> &shard : m_shards)
+            {
+                total += shard->dictionary.size();
+            }
+            return total;
+        }
+
+        uint32_t shards() const
+        {
+            return t_shards;
+        }
+
+    private:
+        static constexpr size_t k_cacheLineSize = 64;
+
+        using Table = Dictionary<key_type, value_type, LockPolicy, Hash>;
+
+        struct alignas(k_cacheLineSize) Shard
+        {
+            explicit Shard(uint32_t capacity)
+                : dictionary(capacity)
+            {
+            }
+
+            Table dictionary;
+        };
+
+        // The low bits of mixHash only depend on the low bits of the key, and its high bits
+        // are the shard's control byte and home slot. The shard therefore comes from the top
+        // of a separately scrambled hash, which neither clusters strided keys nor correlates
+        // with where a key lands inside its shard.
+        Table &shardFor(const key_type &key) const
+        {
+            const uint64_t hash = scrambleHash(Hash{}(key));
+            const uint32_t shard = reduceRange(static_cast<uint32_t>(hash >> 32), t_shards);
+            return m_shards[shard]->dictionary;
+        }
+
+    private:
+        std::array<std::unique_ptr<Shard>, t_shards> m_shards;
+    };
+
+} // namespace SHAMS
@@ -1,143 +1,338 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <stdexcept>
+#include <utility>
+
+#include "ShamsHashing.hpp"
+#include "ShamsLockPolicy.hpp"
+#include "ShamsRobinHoodTable.hpp"
 
 namespace SHAMS
 {
 
-    template <typename key_type, typename value_type>
-    class Dictionary
+    /**
+     * @brief Fixed-capacity hash map with open addressing
+     *
+     * Keys are placed with Robin Hood hashing: an insert that has probed further than the
+     * resident of a slot takes the slot over and carries the resident on, which keeps every
+     * probe sequence short and lets a lookup stop as soon as it meets a key closer to home
+     * than itself. Removal shifts the following keys back instead of leaving tombstones.
+     * There are an eighth more slots than maxCapacity, so a full dictionary is at most ~89%
+     * loaded, and it never grows or rehashes.
+     *
+     * Alongside the keys, every slot has a control byte holding 7 bits of its key's hash, or
+     * an empty marker. Lookups compare 16 control bytes at a time and only read a key when its
+     * hash fragment matches, so most misses never touch the key array. The probing itself is
+     * RobinHoodTable, shared with StaticDictionary.
+     *
+     * With std::string keys the default Hash and Equal are transparent, so contains(), remove()
+     * and operator[] also take a std::string_view, const char* or StaticString and look it up
+     * without allocating a temporary std::string.
+     *
+     * @tparam key_type - The key type, must be default constructible and equality comparable
+     * @tparam value_type - The value type, must be default constructible
+     * @tparam LockPolicy - std::mutex, SpinLock for short critical sections, or NullLock for a dictionary used by one thread only
+     * @tparam Hash - The hash function for key_type
+     * @tparam Equal - The key comparison, must agree with Hash
+     */
+    template <typename key_type, typename value_type, typename LockPolicy = std::mutex, typename Hash = KeyHash<key_type>, typename Equal = KeyEqual<key_type>>
+    class Dictionary : private RobinHoodTable<Dictionary<key_type, value_type, LockPolicy, Hash, Equal>, key_type, value_type, Hash, Equal>
     {
+        using RobinHood = RobinHoodTable<Dictionary, key_type, value_type, Hash, Equal>;
+        friend RobinHood;
+        using RobinHood::k_emptyControl;
+        using RobinHood::k_mirroredControls;
+
     public:
         Dictionary(uint32_t maxCapacity)
             : m_maxCapacity{maxCapacity},
-              m_keys{std::make_unique<key_type[]>(maxCapacity)},
-              m_values{std::make_unique<value_type[]>(maxCapacity)},
-              m_states{std::make_unique<bool[]>(maxCapacity)}
+              m_slotCount{maxCapacity + maxCapacity / 8 + 1},
+              m_keys{std::make_unique<key_type[]>(m_slotCount)},
+              m_values{std::make_unique<value_type[]>(m_slotCount)},
+              m_distances{std::make_unique<uint32_t[]>(m_slotCount)},
+              m_controls{std::make_unique<uint8_t[]>(m_slotCount + k_mirroredControls)},
+              m_occupied{std::make_unique<uint64_t[]>(this->occupancyWords())}
+        {
+            std::fill(m_controls.get(), m_controls.get() + m_slotCount + k_mirroredControls, k_emptyControl);
+        }
+
+        /**
+         * @brief Copies the entries of another dictionary, holding its lock while copying
+         *
+         * @param other - The dictionary to copy
+         */
+        Dictionary(const Dictionary &other)
+            : Dictionary(other.m_maxCapacity)
         {
-            std::fill(m_states.get(), m_states.get() + maxCapacity, false);
+            std::lock_guard<LockPolicy> lock(other.m_lock);
+            std::copy(other.m_keys.get(), other.m_keys.get() + m_slotCount, m_keys.get());
+            std::copy(other.m_values.get(), other.m_values.get() + m_slotCount, m_values.get());
+            std::copy(other.m_distances.get(), other.m_distances.get() + m_slotCount, m_distances.get());
+            std::copy(other.m_controls.get(), other.m_controls.get() + m_slotCount + k_mirroredControls, m_controls.get());
+            std::copy(other.m_occupied.get(), other.m_occupied.get() + this->occupancyWords(), m_occupied.get());
+            this->m_size = other.m_size;
+            this->m_maxDistance = other.m_maxDistance;
         }
 
+        Dictionary &operator=(const Dictionary &) = delete;
+
         bool insert(const key_type &key, const value_type &value)
         {
-            std::lock_guard<std::mutex> lock(m_mutex);
+            std::lock_guard<LockPolicy> lock(m_lock);
             return this->addItem(key, value);
         }
 
         bool remove(const key_type &key)
         {
-            std::lock_guard<std::mutex> lock(m_mutex);
+            std::lock_guard<LockPolicy> lock(m_lock);
+            return this->removeItem(key);
+        }
+
+        template <typename Lookup>
+        bool remove(const Lookup &key)
+            requires TransparentKeyFunctions<Hash, Equal>
+        {
+            std::lock_guard<LockPolicy> lock(m_lock);
             return this->removeItem(key);
         }
 
         bool contains(const key_type &key) const
         {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            return this->hasKey(key);
+            std::lock_guard<LockPolicy> lock(m_lock);
+            return this->findIndex(key) != m_slotCount;
+        }
+
+        template <typename Lookup>
+        bool contains(const Lookup &key) const
+            requires TransparentKeyFunctions<Hash, Equal>
+        {
+            std::lock_guard<LockPolicy> lock(m_lock);
+            return this->findIndex(key) != m_slotCount;
         }
 
         value_type &operator[](const key_type &key)
         {
-            std::lock_guard<std::mutex> lock(m_mutex);
+            std::lock_guard<LockPolicy> lock(m_lock);
             return this->getValue(key);
         }
 
-        uint32_t size() const
+        template <typename Lookup>
+        value_type &operator[](const Lookup &key)
+            requires TransparentKeyFunctions<Hash, Equal>
         {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            return m_size;
+            std::lock_guard<LockPolicy> lock(m_lock);
+            return this->getValue(key);
         }
 
-    private:
-        uint32_t findNextFreeIndex()
+        /**
+         * @brief Looks a key up without throwing
+         *
+         * @note Like operator[], the returned pointer is not protected by the lock.
+         *
+         * @param key - The key to look up
+         * @return value_type* - The stored value, nullptr if the key is not in the dictionary
+         */
+        value_type *find(const key_type &key)
         {
-            if (m_size == m_maxCapacity)
+            std::lock_guard<LockPolicy> lock(m_lock);
+            return this->findValue(key);
+        }
+
+        template <typename Lookup>
+        value_type *find(const Lookup &key)
+            requires TransparentKeyFunctions<Hash, Equal>
+        {
+            std::lock_guard<LockPolicy> lock(m_lock);
+            return this->findValue(key);
+        }
+
+        /**
+         * @brief Constructs a value for a key unless the key is already present, in one probe
+         *
+         * @param key - The key to insert
+         * @param args - The arguments forwarded to the constructor of value_type, unused if the key exists
+         * @return std::pair<value_type *, bool> - The value stored for the key, nullptr if the
+         * dictionary is full, and whether it was inserted by this call
+         */
+        template <typename... Args>
+        std::pair<value_type *, bool> tryEmplace(const key_type &key, Args &&...args)
+        {
+            std::lock_guard<LockPolicy> lock(m_lock);
+            const auto [index, inserted] = this->emplaceItem(key, std::forward<Args>(args)...);
+            return {(index == m_slotCount) ? nullptr : &m_values[index], inserted};
+        }
+
+        /**
+         * @brief Inserts a key and value, or overwrites the value if the key exists, in one probe
+         *
+         * @param key - The key to insert or update
+         * @param value - The value to store
+         * @return std::pair<value_type *, bool> - The value stored for the key, nullptr if the
+         * dictionary is full, and true if it was inserted or false if it was assigned
+         */
+        template <typename Value>
+        std::pair<value_type *, bool> insertOrAssign(const key_type &key, Value &&value)
+        {
+            std::lock_guard<LockPolicy> lock(m_lock);
+            const auto [index, inserted] = this->emplaceItem(key, std::forward<Value>(value));
+            if (index == m_slotCount)
+            {
+                return {nullptr, false};
+            }
+            // emplaceItem only consumes value when it inserts, so it is still intact here
+            if (!inserted)
             {
-                return m_maxCapacity;
+                m_values[index] = std::forward<Value>(value);
+            }
+            return {&m_values[index], inserted};
+        }
+
+        /**
+         * @brief Looks up a batch of keys under a single lock
+         *
+         * Keys are handled in groups: every key of a group is hashed and its home slot
+         * prefetched before any of them is resolved, so the cache misses of a group overlap
+         * instead of following one another.
+         *
+         * @note Like operator[], the returned pointers are not protected by the lock.
+         *
+         * @param keys - The keys to look up
+         * @param values - Receives a pointer to each key's value, or nullptr for a missing key
+         * @throws std::invalid_argument - If values is shorter than keys
+         * @return uint32_t - The number of keys found
+         */
+        uint32_t findMany(std::span<const key_type> keys, std::span<value_type *> values)
+        {
+            if (values.size() < keys.size())
+            {
+                throw std::invalid_argument("Not enough room for the looked up values");
             }
 
-            for (uint32_t i = 0; i < m_maxCapacity; i++)
+            std::lock_guard<LockPolicy> lock(m_lock);
+            uint32_t found = 0;
+            std::array<uint64_t, k_prefetchBatch> hashes;
+            for (size_t first = 0; first < keys.size(); first += k_prefetchBatch)
             {
-                if (m_states[i] == false)
+                const size_t count = std::min<size_t>(k_prefetchBatch, keys.size() - first);
+                for (size_t i = 0; i < count; i++)
+                {
+                    hashes[i] = mixHash(Hash{}(keys[first + i]));
+                    const uint32_t home = this->homeIndex(hashes[i]);
+                    prefetchRead(&m_controls[home]);
+                    prefetchRead(&m_keys[home]);
+                }
+                for (size_t i = 0; i < count; i++)
                 {
-                    return i;
+                    const uint32_t index = this->findIndex(keys[first + i], hashes[i]);
+                    values[first + i] = (index == m_slotCount) ? nullptr : &m_values[index];
+                    found += (index != m_slotCount);
                 }
             }
-            return m_maxCapacity;
+            return found;
         }
 
-        bool hasKey(const key_type &key) const
+        /**
+         * @brief Calls a function for every entry, under the lock
+         *
+         * Occupied slots are found through a bitmap with one bit per slot, so empty stretches
+         * of the table are skipped 64 slots at a time.
+         *
+         * @param function - Called as function(const key_type &key, value_type &value), must not use the dictionary
+         */
+        template <typename Function>
+        void forEach(Function &&function)
         {
-            for (uint32_t i = 0; i < m_maxCapacity; i++)
+            std::lock_guard<LockPolicy> lock(m_lock);
+            for (uint32_t word = 0; word < this->occupancyWords(); word++)
             {
-                if (m_states[i] and m_keys[i] == key)
+                for (uint64_t bits = m_occupied[word]; bits != 0; bits &= bits - 1)
                 {
-                    return true;
+                    const uint32_t index = word * 64 + static_cast<uint32_t>(std::countr_zero(bits));
+                    function(static_cast<const key_type &>(m_keys[index]), m_values[index]);
                 }
             }
-            return false;
+        }
+
+        uint32_t size() const
+        {
+            std::lock_guard<LockPolicy> lock(m_lock);
+            return this->m_size;
+        }
+
+    private:
+        // Enough lookups in flight to cover memory latency without running out of fill buffers
+        static constexpr size_t k_prefetchBatch = 16;
+
+        uint32_t occupancyWords() const
+        {
+            return (m_slotCount + 63) / 64;
         }
 
         bool addItem(const key_type &key, const value_type &value)
         {
+            return this->emplaceItem(key, value).second;
+        }
 
-            uint32_t index = findNextFreeIndex();
-            // Check if the dictionary is full
-            if (index == m_maxCapacity)
-            {
-                return false;
-            }
+        // The storage RobinHoodTable works on
+        uint32_t slotCount() const
+        {
+            return m_slotCount;
+        }
 
-            // Check if the key already exists, no duplicate keys allowed
-            if (this->hasKey(key))
-            {
-                return false;
-            }
+        uint32_t maxCapacity() const
+        {
+            return m_maxCapacity;
+        }
 
-            // Insert the key and value into the free index
-            m_keys[index] = key;
-            m_values[index] = value;
-            m_states[index] = true;
-            m_size++;
-            return true;
+        uint8_t *controls() const
+        {
+            return m_controls.get();
         }
 
-        bool removeItem(const key_type &key)
+        uint32_t *distances() const
         {
-            for (uint32_t i = 0; i < m_maxCapacity; i++)
-            {
-                if (m_states[i] and m_keys[i] == key)
-                {
-                    m_states[i] = false;
-                    m_size--;
-                    return true;
-                }
-            }
-            return false;
+            return m_distances.get();
         }
 
-        value_type &getValue(const key_type &key)
+        key_type &keyAt(uint32_t index) const
         {
-            for (uint32_t i = 0; i < m_maxCapacity; i++)
+            return m_keys[index];
+        }
+
+        value_type &valueAt(uint32_t index) const
+        {
+            return m_values[index];
+        }
+
+        void markOccupied(uint32_t index, bool occupied)
+        {
+            if (occupied)
             {
-                if (m_keys[i] == key)
-                {
-                    return m_values[i];
-                }
+                m_occupied[index / 64] |= uint64_t{1} << (index % 64);
+            }
+            else
+            {
+                m_occupied[index / 64] &= ~(uint64_t{1} << (index % 64));
             }
-            throw std::out_of_range("Key not found");
         }
 
     private:
         const uint32_t m_maxCapacity;
-        mutable std::mutex m_mutex;
-        uint32_t m_size = 0;
+        const uint32_t m_slotCount;
+        mutable LockPolicy m_lock;
         std::unique_ptr<key_type[]> m_keys;
         std::unique_ptr<value_type[]> m_values;
-        std::unique_ptr<bool[]> m_states;
+        std::unique_ptr<uint32_t[]> m_distances;
+        std::unique_ptr<uint8_t[]> m_controls;
+        std::unique_ptr<uint64_t[]> m_occupied;
     };
 
 } // namespace SHAMS
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "ShamsHashing.hpp"
+
+namespace SHAMS
+{
+    /**
+     * @brief Seeded constexpr hash used to build a FrozenDictionary's perfect hash
+     *
+     * Specialised for integers, enums and std::string_view. A custom hash needs the same
+     * constexpr operator()(key, seed) returning a well-mixed 64-bit value.
+     */
+    template <typename key_type>
+    struct FrozenHash;
+
+    template <typename key_type>
+        requires std::is_integral_v<key_type> or std::is_enum_v<key_type>
+    struct FrozenHash<key_type>
+    {
+        constexpr uint64_t operator()(key_type key, uint64_t seed) const
+        {
+            return scrambleHash(static_cast<uint64_t>(key) ^ (seed * 0x9E3779B97F4A7C15ull));
+        }
+    };
+
+    template <>
+    struct FrozenHash<std::string_view>
+    {
+        // FNV-1a over the characters, finalized so the seed changes every bit
+        constexpr uint64_t operator()(std::string_view key, uint64_t seed) const
+        {
+            uint64_t hash = 0xCBF29CE484222325ull;
+            for (char character : key)
+            {
+                hash = (hash ^ static_cast<uint8_t>(character)) * 0x100000001B3ull;
+            }
+            return FrozenHash<uint64_t>{}(hash, seed);
+        }
+    };
+
+    /**
+     * @brief Immutable dictionary with a minimal perfect hash built at compile time
+     *
+     * The N keys are placed with hash-and-displace: each key first hashes into one of N
+     * buckets, and every bucket, largest first, gets the smallest seed that sends all of its
+     * keys to slots nobody holds yet. Every key then has its own slot among exactly N, so a
+     * lookup is two hashes, one array read for the seed and a single key comparison.
+     *
+     * Declared constexpr, the whole table is built by the compiler and lives in read-only
+     * data: no heap, no startup cost. Use std::string_view for string keys.
+     *
+     * @code
+     * constexpr SHAMS::FrozenDictionary<std::string_view, int, 3> commands({{"start", 1}, {"stop", 2}, {"reset", 3}});
+     * static_assert(commands.at("stop") == 2);
+     * @endcode
+     *
+     * @tparam key_type - The key type, integral, enum or std::string_view with the default hash
+     * @tparam value_type - The value type, must be default constructible
+     * @tparam t_size - The number of entries
+     * @tparam Hash - A seeded constexpr hash, see FrozenHash
+     */
+    template <typename key_type, typename value_type, uint32_t t_size, typename Hash = FrozenHash<key_type>>
+    class FrozenDictionary
+    {
+        static_assert(t_size > 0, "FrozenDictionary needs at least one entry");
+
+    public:
+        /**
+         * @brief Builds the dictionary and its perfect hash
+         *
+         * @param entries - The key and value pairs, in any order
+         * @throws std::invalid_argument - If a key appears twice, a compile error when constant evaluated
+         */
+        constexpr FrozenDictionary(const std::pair<key_type, value_type> (&entries)[t_size])
+        {
+            this->build(entries);
+        }
+
+        constexpr bool contains(const key_type &key) const
+        {
+            return this->find(key) != nullptr;
+        }
+
+        /**
+         * @brief Looks a key up
+         *
+         * @param key - The key to look up
+         * @return const value_type* - The stored value, nullptr if the key is not in the dictionary
+         */
+        constexpr const value_type *find(const key_type &key) const
+        {
+            const uint32_t slot = slotFor(key, m_seeds[slotFor(key, 0)]);
+            return (m_keys[slot] == key) ? &m_values[slot] : nullptr;
+        }
+
+        /**
+         * @brief Returns the value stored for a key
+         *
+         * @param key - The key to look up
+         * @throws std::out_of_range - If the key is not in the dictionary
+         * @return const value_type& - The stored value
+         */
+        constexpr const value_type &at(const key_type &key) const
+        {
+            const value_type *value = this->find(key);
+            if (value == nullptr)
+            {
+                throw std::out_of_range("Key not found");
+            }
+            return *value;
+        }
+
+        constexpr const value_type &operator[](const key_type &key) const
+        {
+            return this->at(key);
+        }
+
+        constexpr uint32_t size() const
+        {
+            return t_size;
+        }
+
+    private:
+        static constexpr uint32_t k_maxSeed = 1u << 24;
+
+        static constexpr uint32_t slotFor(const key_type &key, uint32_t seed)
+        {
+            return reduceRange(static_cast<uint32_t>(Hash{}(key, seed) >> 32), t_size);
+        }
+
+        constexpr void build(const std::pair<key_type, value_type> (&entries)[t_size])
+        {
+            // Group the entries by bucket with a counting sort
+            std::array<uint32_t, t_size + 1> bucketStart{};
+            for (uint32_t i = 0; i < t_size; i++)
+            {
+                bucketStart[slotFor(entries[i].first, 0) + 1]++;
+            }
+            for (uint32_t bucket = 0; bucket < t_size; bucket++)
+            {
+                bucketStart[bucket + 1] += bucketStart[bucket];
+            }
+            std::array<uint32_t, t_size> members{};
+            std::array<uint32_t, t_size> filled{};
+            for (uint32_t i = 0; i < t_size; i++)
+            {
+                const uint32_t bucket = slotFor(entries[i].first, 0);
+                members[bucketStart[bucket] + filled[bucket]++] = i;
+            }
+
+            // Crowded buckets are placed first, while most slots are still free
+            std::array<uint32_t, t_size> order{};
+            for (uint32_t bucket = 0; bucket < t_size; bucket++)
+            {
+                order[bucket] = bucket;
+            }
+            std::sort(order.begin(), order.end(), [&bucketStart](uint32_t left, uint32_t right)
+                      { return bucketStart[left + 1] - bucketStart[left] > bucketStart[right + 1] - bucketStart[right]; });
+
+            std::array<bool, t_size> taken{};
+            std::array<uint32_t, t_size> slots{};
+            for (uint32_t bucket : order)
+            {
+                const uint32_t first = bucketStart[bucket];
+                const uint32_t count = bucketStart[bucket + 1] - first;
+                if (count == 0)
+                {
+                    break;
+                }
+                for (uint32_t i = first; i < first + count; i++)
+                {
+                    for (uint32_t j = first; j < i; j++)
+                    {
+                        if (entries[members[i]].first == entries[members[j]].first)
+                        {
+                            throw std::invalid_argument("Duplicate key");
+                        }
+                    }
+                }
+                m_seeds[bucket] = this->findSeed(entries, members, first, count, taken, slots);
+            }
+
+            for (uint32_t i = 0; i < t_size; i++)
+            {
+                m_keys[slots[i]] = entries[i].first;
+                m_values[slots[i]] = entries[i].second;
+            }
+        }
+
+        // Tries seeds in turn until every key of the bucket lands on a distinct free slot
+        constexpr uint32_t findSeed(const std::pair<key_type, value_type> (&entries)[t_size], const std::array<uint32_t, t_size> &members,
+                                    uint32_t first, uint32_t count, std::array<bool, t_size> &taken, std::array<uint32_t, t_size> &slots) const
+        {
+            for (uint32_t seed = 1; seed < k_maxSeed; seed++)
+            {
+                bool placed = true;
+                for (uint32_t i = first; i < first + count and placed; i++)
+                {
+                    const uint32_t slot = slotFor(entries[members[i]].first, seed);
+                    placed = !taken[slot];
+                    for (uint32_t j = first; j < i and placed; j++)
+                    {
+                        placed = slots[members[j]] != slot;
+                    }
+                    slots[members[i]] = slot;
+                }
+                if (placed)
+                {
+                    for (uint32_t i = first; i < first + count; i++)
+                    {
+                        taken[slots[members[i]]] = true;
+                    }
+                    return seed;
+                }
+            }
+            throw std::invalid_argument("Unable to find a perfect hash for the keys");
+        }
+
+    private:
+        std::array<key_type, t_size> m_keys{};
+        std::array<value_type, t_size> m_values{};
+        std::array<uint32_t, t_size> m_seeds{};
+    };
+
+} // namespace SHAMS
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include "ShamsStaticString.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SHAMS_HAS_SSE2 1
+#endif
+
+namespace SHAMS
+{
+    /**
+     * @brief Spreads a hash over all 64 bits
+     *
+     * std::hash of an integer is often the identity, so its high bits are zero and nearby keys
+     * hash to nearby values. A Fibonacci multiply moves every input bit into the high bits,
+     * which is where the hash tables take their slot index from.
+     *
+     * @param hash - The raw hash of a key
+     * @return uint64_t - The mixed hash
+     */
+    constexpr uint64_t mixHash(size_t hash)
+    {
+        return static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ull;
+    }
+
+    /**
+     * @brief Derives a second hash, independent of mixHash, from the raw hash of a key
+     *
+     * The splitmix64 finalizer, in which every input bit affects every output bit. Used where
+     * a container picks something other than a slot from the hash, so that choice does not
+     * correlate with the bits its tables use.
+     *
+     * @param hash - The raw hash of a key
+     * @return uint64_t - The scrambled hash
+     */
+    constexpr uint64_t scrambleHash(uint64_t hash)
+    {
+        hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+        hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+        return hash ^ (hash >> 31);
+    }
+
+    /**
+     * @brief Maps a 32-bit value onto [0, range) without a division
+     *
+     * @param value - A uniformly distributed value, such as the high half of a mixed hash
+     * @param range - The size of the target range
+     * @return uint32_t - The value scaled into the range
+     */
+    constexpr uint32_t reduceRange(uint32_t value, uint32_t range)
+    {
+        return static_cast<uint32_t>((static_cast<uint64_t>(value) * range) >> 32);
+    }
+
+    /**
+     * @brief Compares a group of 16 control bytes against one value
+     *
+     * Uses a single SSE2 compare where available and a scalar loop otherwise.
+     *
+     * @param group - The first of 16 readable control bytes
+     * @param control - The value to look for
+     * @return uint32_t - A mask with bit i set where group[i] equals control
+     */
+    inline uint32_t matchControlGroup(const uint8_t *group, uint8_t control)
+    {
+#if defined(SHAMS_HAS_SSE2)
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+        const __m128i matches = _mm_cmpeq_epi8(bytes, _mm_set1_epi8(static_cast<char>(control)));
+        return static_cast<uint32_t>(_mm_movemask_epi8(matches));
+#else
+        uint32_t mask = 0;
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            mask |= static_cast<uint32_t>(group[i] == control) << i;
+        }
+        return mask;
+#endif
+    }
+
+    /**
+     * @brief Hints the CPU to start loading the cache line at address
+     *
+     * A no-op on compilers without a prefetch builtin.
+     *
+     * @param address - Memory that is about to be read
+     */
+    inline void prefetchRead(const void *address)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address, 0, 3);
+#elif defined(SHAMS_HAS_SSE2)
+        _mm_prefetch(static_cast<const char *>(address), _MM_HINT_T0);
+#else
+        (void)address;
+#endif
+    }
+
+    /**
+     * @brief Default hash for the hash tables, std::hash unless specialised below
+     */
+    template <typename key_type>
+    struct KeyHash : std::hash<key_type>
+    {
+    };
+
+    /**
+     * @brief Default key comparison for the hash tables, std::equal_to unless specialised below
+     */
+    template <typename key_type>
+    struct KeyEqual : std::equal_to<key_type>
+    {
+    };
+
+    /**
+     * @brief Transparent hash for std::string keys
+     *
+     * std::string, std::string_view, const char* and StaticString all hash through
+     * std::hash<std::string_view>, which the standard guarantees matches std::hash<std::string>,
+     * so a table can be searched with any of them without building a std::string.
+     */
+    template <>
+    struct KeyHash<std::string>
+    {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view key) const
+        {
+            return std::hash<std::string_view>{}(key);
+        }
+
+        template <size_t t_maxLength>
+        size_t operator()(const StaticString<t_maxLength> &key) const
+        {
+            return (*this)(std::string_view(key.c_str(), key.length()));
+        }
+    };
+
+    /**
+     * @brief Transparent comparison for std::string keys, see KeyHash<std::string>
+     */
+    template <>
+    struct KeyEqual<std::string>
+    {
+        using is_transparent = void;
+
+        bool operator()(std::string_view key, std::string_view lookup) const
+        {
+            return key == lookup;
+        }
+
+        template <size_t t_maxLength>
+        bool operator()(std::string_view key, const StaticString<t_maxLength> &lookup) const
+        {
+            return key == std::string_view(lookup.c_str(), lookup.length());
+        }
+    };
+
+    /**
+     * @brief Transparent hash for StaticString keys, hashing the same as KeyHash<std::string>
+     */
+    template <size_t t_maxLength>
+    struct KeyHash<StaticString<t_maxLength>> : KeyHash<std::string>
+    {
+    };
+
+    /**
+     * @brief Transparent comparison for StaticString keys
+     */
+    template <size_t t_maxLength>
+    struct KeyEqual<StaticString<t_maxLength>>
+    {
+        using is_transparent = void;
+
+        template <typename Lookup>
+        bool operator()(const StaticString<t_maxLength> &key, const Lookup &lookup) const
+        {
+            return KeyEqual<std::string>{}(std::string_view(key.c_str(), key.length()), lookup);
+        }
+    };
+
+    /**
+     * @brief Satisfied when both key functions accept lookup types other than the key type
+     */
+    template <typename Hash, typename Equal>
+    concept TransparentKeyFunctions = requires {
+        typename Hash::is_transparent;
+        typename Equal::is_transparent;
+    };
+
+} // namespace SHAMS
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace SHAMS
+{
+    /**
+     * @brief Lock policy that does nothing, for containers only ever touched by one thread
+     *
+     * Satisfies Lockable, so it drops into std::lock_guard and std::unique_lock, and every
+     * call compiles away.
+     */
+    class NullLock
+    {
+    public:
+        void lock() {}
+
+        bool try_lock()
+        {
+            return true;
+        }
+
+        void unlock() {}
+    };
+
+    /**
+     * @brief Test-and-test-and-set spinlock for short critical sections
+     *
+     * Waiters spin on a plain load so the cache line stays shared until the lock is released,
+     * pausing between reads with an exponentially growing backoff. Once the backoff is at its
+     * limit the waiter yields its time slice, so a preempted holder can still make progress.
+     * An uncontended lock and unlock is one atomic exchange and one store, with no system call.
+     */
+    class SpinLock
+    {
+    public:
+        void lock()
+        {
+            uint32_t spins = 1;
+            while (m_locked.exchange(true, std::memory_order_acquire))
+            {
+                while (m_locked.load(std::memory_order_relaxed))
+                {
+                    if (spins < k_maxSpins)
+                    {
+                        for (uint32_t i = 0; i < spins; i++)
+                        {
+                            cpuRelax();
+                        }
+                        spins *= 2;
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+        }
+
+        bool try_lock()
+        {
+            return !m_locked.load(std::memory_order_relaxed) and !m_locked.exchange(true, std::memory_order_acquire);
+        }
+
+        void unlock()
+        {
+            m_locked.store(false, std::memory_order_release);
+        }
+
+    private:
+        static constexpr uint32_t k_maxSpins = 64;
+
+        // Tells the core it is in a spin-wait, which saves power and frees pipeline resources
+        // for a sibling hyperthread
+        static void cpuRelax()
+        {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+            asm volatile("yield");
+#endif
+        }
+
+    private:
+        std::atomic<bool> m_locked = false;
+    };
+
+} // namespace SHAMS
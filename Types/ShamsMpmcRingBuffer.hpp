@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cstdint>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <stdexcept>
+
+#include "ShamsQueueStats.hpp"
+
+namespace SHAMS
+{
+    /**
+     * @brief Bounded lock-free ring buffer for any number of producer and consumer threads
+     *
+     * Storage is a fixed std::array, like the static RingBuffer<T, capacity>, so the queue never
+     * touches the heap. Every slot carries a sequence number that tells producers and consumers
+     * whose turn it is, so each side claims a slot with a single compare-and-swap on its own
+     * position counter instead of serializing on a global lock.
+     *
+     * @tparam T - The item type, must be default constructible and copy assignable
+     * @tparam t_capacity - The number of slots, must be a power of two
+     * @tparam StatsPolicy - QueueStatsCounters to collect traffic counters for stats(), NoQueueStats to compile them out
+     */
+    template <typename T, uint32_t t_capacity, typename StatsPolicy = NoQueueStats>
+    class MpmcRingBuffer
+    {
+        static_assert(std::has_single_bit(t_capacity), "MpmcRingBuffer capacity must be a power of two");
+
+    public:
+        MpmcRingBuffer()
+        {
+            for (uint32_t i = 0; i < t_capacity; i++)
+            {
+                m_slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Pushes an item onto the tail of the buffer
+         *
+         * @param item - The item to push
+         * @return bool - True if the item was pushed, false if the buffer is full
+         */
+        bool push(const T &item)
+        {
+            uint32_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+            while (true)
+            {
+                Slot &slot = m_slots[position & k_mask];
+                const uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+                const int32_t difference = static_cast<int32_t>(sequence - position);
+
+                if (difference == 0)
+                {
+                    // The slot is free for this lap, try to claim it
+                    if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        slot.item = item;
+                        slot.sequence.store(position + 1, std::memory_order_release);
+                        if constexpr (StatsPolicy::enabled)
+                        {
+                            m_stats.recordPush(1, this->size());
+                        }
+                        return true;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    // The slot still holds an item from the previous lap
+                    m_stats.recordRejectedPush();
+                    return false;
+                }
+                else
+                {
+                    // Another producer claimed the slot first
+                    position = m_enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * @brief Pops an item from the head of the buffer
+         *
+         * @param item - Receives the popped item
+         * @return bool - True if an item was popped, false if the buffer is empty
+         */
+        bool pop(T &item)
+        {
+            uint32_t position = m_dequeuePosition.load(std::memory_order_relaxed);
+            while (true)
+            {
+                Slot &slot = m_slots[position & k_mask];
+                const uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+                const int32_t difference = static_cast<int32_t>(sequence - (position + 1));
+
+                if (difference == 0)
+                {
+                    if (m_dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        item = slot.item;
+                        slot.sequence.store(position + t_capacity, std::memory_order_release);
+                        m_stats.recordPop(1);
+                        return true;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    // The producer for this slot has not published yet
+                    m_stats.recordFailedPop();
+                    return false;
+                }
+                else
+                {
+                    position = m_dequeuePosition.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * @brief Returns the number of items in the buffer
+         *
+         * @note With concurrent producers and consumers the value is a snapshot that may
+         * already be stale when it is returned.
+         *
+         * @return uint32_t - The number of items in the buffer
+         */
+        uint32_t size() const
+        {
+            const uint32_t dequeue = m_dequeuePosition.load(std::memory_order_acquire);
+            const uint32_t enqueue = m_enqueuePosition.load(std::memory_order_acquire);
+            const int32_t difference = static_cast<int32_t>(enqueue - dequeue);
+            return (difference < 0) ? 0 : static_cast<uint32_t>(difference);
+        }
+
+        uint32_t capacity() const
+        {
+            return t_capacity;
+        }
+
+        /**
+         * @brief Returns a snapshot of the traffic counters, all zero unless StatsPolicy is QueueStatsCounters
+         *
+         * peakSize is taken from size() after each push, so like size() it is a snapshot.
+         *
+         * @return QueueStats - The counters since construction, contendedLocks is always zero
+         */
+        QueueStats stats() const
+        {
+            return m_stats.snapshot();
+        }
+
+    private:
+        static constexpr uint32_t k_mask = t_capacity - 1;
+        static constexpr size_t k_cacheLineSize = 64;
+
+        struct Slot
+        {
+            std::atomic<uint32_t> sequence;
+            T item;
+        };
+
+        std::array<Slot, t_capacity> m_slots;
+        alignas(k_cacheLineSize) std::atomic<uint32_t> m_enqueuePosition = 0;
+        alignas(k_cacheLineSize) std::atomic<uint32_t> m_dequeuePosition = 0;
+        [[no_unique_address]] StatsPolicy m_stats;
+    };
+
+} // namespace SHAMS
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace SHAMS
+{
+    /**
+     * @brief Snapshot of a queue's traffic counters
+     */
+    struct QueueStats
+    {
+        uint64_t pushes = 0;          ///< Items successfully pushed
+        uint64_t pops = 0;            ///< Items successfully popped
+        uint64_t rejectedPushes = 0;  ///< Items refused because the queue was full
+        uint64_t failedPops = 0;      ///< Pop attempts that found the queue empty
+        uint32_t peakSize = 0;        ///< Highest number of items held at once
+        uint64_t contendedLocks = 0;  ///< Lock acquisitions where try_lock would have failed, always zero for lock-free queues
+    };
+
+    /**
+     * @brief Stats policy that collects QueueStats
+     *
+     * Counters are relaxed atomics: stats() reads them without blocking the queue, and the
+     * lock-free queues update them from several threads at once. Producer and consumer
+     * counters sit on separate cache lines, so the two sides of a lock-free queue do not
+     * contend over them.
+     */
+    class QueueStatsCounters
+    {
+    public:
+        static constexpr bool enabled = true;
+
+        void recordPush(uint32_t count, uint32_t sizeAfter)
+        {
+            m_pushes.fetch_add(count, std::memory_order_relaxed);
+            uint32_t peak = m_peakSize.load(std::memory_order_relaxed);
+            while (sizeAfter > peak and !m_peakSize.compare_exchange_weak(peak, sizeAfter, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        void recordPop(uint32_t count)
+        {
+            m_pops.fetch_add(count, std::memory_order_relaxed);
+        }
+
+        void recordRejectedPush(uint32_t count = 1)
+        {
+            m_rejectedPushes.fetch_add(count, std::memory_order_relaxed);
+        }
+
+        void recordFailedPop()
+        {
+            m_failedPops.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void recordContention()
+        {
+            m_contendedLocks.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        QueueStats snapshot() const
+        {
+            QueueStats stats;
+            stats.pushes = m_pushes.load(std::memory_order_relaxed);
+            stats.pops = m_pops.load(std::memory_order_relaxed);
+            stats.rejectedPushes = m_rejectedPushes.load(std::memory_order_relaxed);
+            stats.failedPops = m_failedPops.load(std::memory_order_relaxed);
+            stats.peakSize = m_peakSize.load(std::memory_order_relaxed);
+            stats.contendedLocks = m_contendedLocks.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+    private:
+        static constexpr size_t k_cacheLineSize = 64;
+
+        alignas(k_cacheLineSize) std::atomic<uint64_t> m_pushes = 0;
+        std::atomic<uint64_t> m_rejectedPushes = 0;
+        std::atomic<uint32_t> m_peakSize = 0;
+        alignas(k_cacheLineSize) std::atomic<uint64_t> m_pops = 0;
+        std::atomic<uint64_t> m_failedPops = 0;
+        std::atomic<uint64_t> m_contendedLocks = 0;
+    };
+
+    /**
+     * @brief Stats policy that collects nothing, the default
+     *
+     * Every hook is an empty inline function, so queues built with it compile to the same
+     * code as before stats existed.
+     */
+    class NoQueueStats
+    {
+    public:
+        static constexpr bool enabled = false;
+
+        void recordPush(uint32_t, uint32_t) {}
+        void recordPop(uint32_t) {}
+        void recordRejectedPush(uint32_t = 1) {}
+        void recordFailedPop() {}
+        void recordContention() {}
+
+        QueueStats snapshot() const
+        {
+            return {};
+        }
+    };
+
+} // namespace SHAMS
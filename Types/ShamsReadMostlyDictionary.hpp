@@ -0,0 +1,198 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "ShamsDictionary.hpp"
+#include "ShamsLockPolicy.hpp"
+
+namespace SHAMS
+{
+    /**
+     * @brief Dictionary for tables that are read constantly and written rarely
+     *
+     * Readers never take a lock. They look entries up in an immutable snapshot reached through
+     * an atomic pointer. A writer copies the current snapshot, applies its change to the copy
+     * and publishes the copy, then frees the old snapshot once no reader can still be using it.
+     *
+     * Readers announce themselves on one of several cache-line-sized reader slots, picked per
+     * thread, in one of two counters selected by the parity of the snapshot version. A writer
+     * flips the version after publishing and waits only for the counters of the old parity to
+     * drain, so readers that arrive later never hold it up.
+     *
+     * Every write copies the whole table, so writes cost O(maxCapacity) and are serialised.
+     *
+     * @tparam key_type - The key type
+     * @tparam value_type - The value type, returned by copy so nothing points into a freed snapshot
+     * @tparam Hash - The hash function for key_type
+     */
+    template <typename key_type, typename value_type, typename Hash = KeyHash<key_type>>
+    class ReadMostlyDictionary
+    {
+    public:
+        ReadMostlyDictionary(uint32_t maxCapacity)
+            : m_current(new Table(maxCapacity))
+        {
+        }
+
+        ReadMostlyDictionary(const ReadMostlyDictionary &) = delete;
+        ReadMostlyDictionary &operator=(const ReadMostlyDictionary &) = delete;
+
+        ~ReadMostlyDictionary()
+        {
+            delete m_current.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Inserts a key and value by publishing a new snapshot
+         *
+         * @param key - The key to insert
+         * @param value - The value to store
+         * @return bool - True if inserted, false if the key already exists or the dictionary is full
+         */
+        bool insert(const key_type &key, const value_type &value)
+        {
+            return this->write([&key, &value](Table &table)
+                               { return table.insert(key, value); });
+        }
+
+        /**
+         * @brief Removes a key by publishing a new snapshot
+         *
+         * @param key - The key to remove
+         * @return bool - True if the key was removed, false if it was not present
+         */
+        bool remove(const key_type &key)
+        {
+            return this->write([&key](Table &table)
+                               { return table.remove(key); });
+        }
+
+        bool contains(const key_type &key) const
+        {
+            ReadGuard guard(*this);
+            return guard.table().contains(key);
+        }
+
+        /**
+         * @brief Returns a copy of the value stored for a key, without taking a lock
+         *
+         * @param key - The key to look up
+         * @throws std::out_of_range - If the key is not in the dictionary
+         * @return value_type - The stored value
+         */
+        value_type operator[](const key_type &key) const
+        {
+            ReadGuard guard(*this);
+            return guard.table()[key];
+        }
+
+        uint32_t size() const
+        {
+            ReadGuard guard(*this);
+            return guard.table().size();
+        }
+
+    private:
+        static constexpr size_t k_cacheLineSize = 64;
+        static constexpr uint32_t k_readerSlots = 16;
+
+        // Snapshots are never modified once published, so they need no lock of their own
+        using Table = Dictionary<key_type, value_type, NullLock, Hash>;
+
+        struct alignas(k_cacheLineSize) ReaderSlot
+        {
+            std::array<std::atomic<uint32_t>, 2> active{};
+        };
+
+        // Registers the reader under the current version's parity for as long as it is alive.
+        // The version is checked again after registering: if a writer flipped it in between,
+        // the writer may already have stopped waiting on that parity, so the reader retries.
+        class ReadGuard
+        {
+        public:
+            explicit ReadGuard(const ReadMostlyDictionary &dictionary)
+                : m_slot(dictionary.readerSlot())
+            {
+                for (;;)
+                {
+                    const uint32_t version = dictionary.m_version.load(std::memory_order_seq_cst);
+                    m_parity = version & 1;
+                    m_slot.active[m_parity].fetch_add(1, std::memory_order_seq_cst);
+                    if (dictionary.m_version.load(std::memory_order_seq_cst) == version)
+                    {
+                        break;
+                    }
+                    m_slot.active[m_parity].fetch_sub(1, std::memory_order_release);
+                }
+                m_table = dictionary.m_current.load(std::memory_order_seq_cst);
+            }
+
+            ReadGuard(const ReadGuard &) = delete;
+            ReadGuard &operator=(const ReadGuard &) = delete;
+
+            ~ReadGuard()
+            {
+                m_slot.active[m_parity].fetch_sub(1, std::memory_order_release);
+            }
+
+            Table &table() const
+            {
+                return *m_table;
+            }
+
+        private:
+            ReaderSlot &m_slot;
+            uint32_t m_parity = 0;
+            Table *m_table = nullptr;
+        };
+
+        // Threads are spread over the slots round-robin the first time they read
+        ReaderSlot &readerSlot() const
+        {
+            static std::atomic<uint32_t> s_nextSlot = 0;
+            thread_local const uint32_t slot = s_nextSlot.fetch_add(1, std::memory_order_relaxed) % k_readerSlots;
+            return m_readerSlots[slot];
+        }
+
+        template <typename Change>
+        bool write(Change &&change)
+        {
+            std::lock_guard<std::mutex> lock(m_writeMutex);
+            Table *previous = m_current.load(std::memory_order_relaxed);
+            auto next = std::make_unique<Table>(*previous);
+            if (!change(*next))
+            {
+                return false;
+            }
+            m_current.store(next.release(), std::memory_order_seq_cst);
+            const uint32_t oldParity = m_version.fetch_add(1, std::memory_order_seq_cst) & 1;
+            this->waitForReaders(oldParity);
+            delete previous;
+            return true;
+        }
+
+        void waitForReaders(uint32_t parity) const
+        {
+            for (const ReaderSlot &slot : m_readerSlots)
+            {
+                while (slot.active[parity].load(std::memory_order_acquire) != 0)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+    private:
+        std::atomic<Table *> m_current;
+        std::atomic<uint32_t> m_version = 0;
+        std::mutex m_writeMutex;
+        mutable std::array<ReaderSlot, k_readerSlots> m_readerSlots;
+    };
+
+} // namespace SHAMS
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+
+namespace SHAMS
+{
+    /**
+     * @brief Single-producer/single-consumer byte ring that stores variable-length records
+     *
+     * Each record is stored contiguously as a 4-byte length prefix followed by its payload,
+     * padded to a 4-byte boundary, so the memory a queue needs is the total size of the
+     * queued records rather than its depth times the largest record. A record is never split:
+     * when it does not fit before the end of the storage the producer writes a wrap marker and
+     * continues from the start.
+     *
+     * @note Lock-free, exactly one thread may write and exactly one thread may read.
+     */
+    class RecordRingBuffer
+    {
+    public:
+        /**
+         * @brief Constructs the buffer
+         *
+         * @param capacity - The storage size in bytes, rounded up to a power of two of at least 8
+         */
+        RecordRingBuffer(uint32_t capacity)
+            : m_capacity(std::bit_ceil(std::max<uint32_t>(capacity, 8))),
+              m_buffer(std::make_unique<std::byte[]>(m_capacity))
+        {
+        }
+
+        /**
+         * @brief Copies a record into the buffer, producer thread only
+         *
+         * @param record - The record payload, at most maxRecordLength() bytes
+         * @return bool - True if the record was written, false if there is not enough free space
+         */
+        bool tryWrite(std::span<const std::byte> record)
+        {
+            if (record.size() > this->maxRecordLength())
+            {
+                return false;
+            }
+            const uint32_t size = recordSize(static_cast<uint32_t>(record.size()));
+            uint32_t tail = m_tail.load(std::memory_order_relaxed);
+            const uint32_t toEnd = m_capacity - (tail & (m_capacity - 1));
+            const uint32_t needed = (size <= toEnd) ? size : toEnd + size;
+
+            if (m_capacity - (tail - m_cachedHead) < needed)
+            {
+                m_cachedHead = m_head.load(std::memory_order_acquire);
+                if (m_capacity - (tail - m_cachedHead) < needed)
+                {
+                    return false;
+                }
+            }
+
+            if (size > toEnd)
+            {
+                this->writeHeader(tail, k_wrapMarker);
+                tail += toEnd;
+            }
+            this->writeHeader(tail, static_cast<uint32_t>(record.size()));
+            if (!record.empty())
+            {
+                std::memcpy(&m_buffer[(tail & (m_capacity - 1)) + k_headerSize], record.data(), record.size());
+            }
+            m_tail.store(tail + size, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Returns a view of the oldest record without removing it, consumer thread only
+         *
+         * The view points into the buffer and stays valid until release() is called.
+         *
+         * @return std::optional<std::span<const std::byte>> - The record payload, empty if there is no record
+         */
+        std::optional<std::span<const std::byte>> tryRead()
+        {
+            uint32_t head = m_head.load(std::memory_order_relaxed);
+            if (head == m_cachedTail)
+            {
+                m_cachedTail = m_tail.load(std::memory_order_acquire);
+                if (head == m_cachedTail)
+                {
+                    return std::nullopt;
+                }
+            }
+
+            uint32_t length = this->readHeader(head);
+            if (length == k_wrapMarker)
+            {
+                // The marker is always published together with the record after it
+                head += m_capacity - (head & (m_capacity - 1));
+                length = this->readHeader(head);
+            }
+            m_readHead = head;
+            m_readLength = length;
+            m_readPending = true;
+            return std::span<const std::byte>(&m_buffer[(head & (m_capacity - 1)) + k_headerSize], length);
+        }
+
+        /**
+         * @brief Removes the record returned by the last tryRead(), consumer thread only
+         *
+         * @throws std::out_of_range - If tryRead() has not returned a record since the last release()
+         */
+        void release()
+        {
+            if (!m_readPending)
+            {
+                throw std::out_of_range("Release without a read record");
+            }
+            m_head.store(m_readHead + recordSize(m_readLength), std::memory_order_release);
+            m_readPending = false;
+        }
+
+        /**
+         * @brief Returns the number of bytes in use, including length prefixes and padding
+         *
+         * @return uint32_t - The used bytes
+         */
+        uint32_t usedBytes() const
+        {
+            return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+        }
+
+        uint32_t capacity() const
+        {
+            return m_capacity;
+        }
+
+        /**
+         * @brief Returns the largest record payload the buffer accepts
+         *
+         * A record may need the space left before the end of the storage plus its own size,
+         * so records are limited to half the capacity to guarantee they always fit eventually.
+         *
+         * @return uint32_t - The maximum payload length in bytes
+         */
+        uint32_t maxRecordLength() const
+        {
+            return m_capacity / 2 - k_headerSize;
+        }
+
+    private:
+        static constexpr uint32_t k_headerSize = sizeof(uint32_t);
+        static constexpr uint32_t k_wrapMarker = UINT32_MAX;
+        static constexpr size_t k_cacheLineSize = 64;
+
+        // Records stay 4-byte aligned, so at least a header always fits before the end of the storage
+        static uint32_t recordSize(uint32_t length)
+        {
+            return k_headerSize + ((length + k_headerSize - 1) & ~(k_headerSize - 1));
+        }
+
+        void writeHeader(uint32_t position, uint32_t length)
+        {
+            std::memcpy(&m_buffer[position & (m_capacity - 1)], &length, k_headerSize);
+        }
+
+        uint32_t readHeader(uint32_t position) const
+        {
+            uint32_t length = 0;
+            std::memcpy(&length, &m_buffer[position & (m_capacity - 1)], k_headerSize);
+            return length;
+        }
+
+    private:
+        // Byte positions run freely and wrap at 2^32, a multiple of the power-of-two capacity
+        const uint32_t m_capacity;
+        std::unique_ptr<std::byte[]> m_buffer;
+        alignas(k_cacheLineSize) std::atomic<uint32_t> m_tail = 0;
+        uint32_t m_cachedHead = 0;
+        alignas(k_cacheLineSize) std::atomic<uint32_t> m_head = 0;
+        uint32_t m_cachedTail = 0;
+        uint32_t m_readHead = 0;
+        uint32_t m_readLength = 0;
+        bool m_readPending = false;
+    };
+
+} // namespace SHAMS
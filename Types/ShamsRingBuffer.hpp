@@ -1,53 +1,441 @@
 #pragma once
 
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
 #include <cstdint>
+#include <cstring>
 #include <mutex>
 #include <memory>
+#include <optional>
+#include <span>
 #include <stdexcept>
+#include <type_traits>
+
+#include "ShamsLockPolicy.hpp"
+#include "ShamsQueueStats.hpp"
 
 namespace SHAMS
 {
-    template <typename T>
+    /**
+     * @brief How a runtime-sized RingBuffer treats the requested capacity
+     */
+    enum class CapacityMode
+    {
+        Exact,              ///< Use the capacity as given, mask indexing only if it is already a power of two
+        RoundUpToPowerOfTwo ///< Round the capacity up to a power of two so indices are always masked
+    };
+
+    /**
+     * @brief What a RingBuffer does with a push that arrives while it is full
+     */
+    enum class OverflowPolicy
+    {
+        Reject,         ///< Keep the stored items and fail the push
+        OverwriteOldest ///< Drop the oldest item to make room, so the buffer holds the most recent items
+    };
+
+    /**
+     * @tparam T - The item type
+     * @tparam LockPolicy - std::mutex, SpinLock for short critical sections, or NullLock for a buffer used by one thread only
+     * @tparam StatsPolicy - QueueStatsCounters to collect traffic counters for stats(), NoQueueStats to compile them out
+     */
+    template <typename T, typename LockPolicy = std::mutex, typename StatsPolicy = NoQueueStats>
     class RingBuffer
     {
+        class PopAwaiter;
+        class PushAwaiter;
 
     public:
-        RingBuffer(uint32_t capacity)
-            : m_buffer(std::make_unique<T[]>(capacity)),
-              m_capacity(capacity)
+        RingBuffer(uint32_t capacity, CapacityMode mode = CapacityMode::Exact, OverflowPolicy policy = OverflowPolicy::Reject)
+            : m_capacity((mode == CapacityMode::RoundUpToPowerOfTwo) ? std::bit_ceil(capacity) : capacity),
+              m_powerOfTwo(std::has_single_bit(m_capacity)),
+              m_overflowPolicy(policy),
+              m_buffer(std::allocator<T>().allocate(m_capacity), StorageDeleter{m_capacity})
+        {
+        }
+
+        RingBuffer(uint32_t capacity, OverflowPolicy policy)
+            : RingBuffer(capacity, CapacityMode::Exact, policy)
+        {
+        }
+
+        ~RingBuffer()
         {
+            this->destroyItems(m_head, this->count());
         }
 
+        /**
+         * @brief Pushes an item onto the tail of the buffer
+         *
+         * With OverflowPolicy::OverwriteOldest a full buffer drops its oldest item instead of
+         * failing, unless a consumer is holding a peek() view that the overwrite would tear.
+         *
+         * @param item - The item to push
+         * @return bool - True if the item was pushed, false if the buffer is full
+         */
         bool push(const T &item)
         {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            if (m_size == m_capacity)
+            return this->emplace(item);
+        }
+
+        bool push(T &&item)
+        {
+            return this->emplace(std::move(item));
+        }
+
+        /**
+         * @brief Constructs an item in place at the tail of the buffer
+         *
+         * @param args - The arguments forwarded to the constructor of T
+         * @return bool - True if the item was pushed, false if the buffer is full
+         */
+        template <typename... Args>
+        bool emplace(Args &&...args)
+        {
+            std::unique_lock<LockPolicy> lock = this->acquire();
+            if (!this->makeRoomForOne())
             {
+                m_stats.recordRejectedPush();
                 return false;
             }
-            m_buffer[m_tail] = item;
-            m_tail = (m_tail + 1) % m_capacity;
-            m_size++;
+            this->constructItem(std::forward<Args>(args)...);
+            this->notifyConsumers(lock, 1);
             return true;
         }
 
+        /**
+         * @brief Moves the item at the head of the buffer out and destroys its slot
+         *
+         * @param item - Receives the popped item
+         * @return bool - True if an item was popped, false if the buffer is empty
+         */
         bool pop(T &item)
         {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            if (m_size == 0)
+            std::unique_lock<LockPolicy> lock = this->acquire();
+            if (this->count() == 0)
             {
+                m_stats.recordFailedPop();
                 return false;
             }
-            item = m_buffer[m_head];
-            m_head = (m_head + 1) % m_capacity;
-            m_size--;
+            this->popItem(item);
+            this->notifyProducers(lock, 1);
             return true;
         }
 
+        /**
+         * @brief Moves the item at the head of the buffer out and destroys its slot
+         *
+         * @return std::optional<T> - The popped item, empty if the buffer is empty
+         */
+        std::optional<T> pop()
+        {
+            std::unique_lock<LockPolicy> lock = this->acquire();
+            if (this->count() == 0)
+            {
+                m_stats.recordFailedPop();
+                return std::nullopt;
+            }
+            T *head = &m_buffer[this->slot(m_head)];
+            std::optional<T> item(std::move(*head));
+            std::destroy_at(head);
+            this->advanceHead(1);
+            m_stats.recordPop(1);
+            this->notifyProducers(lock, 1);
+            return item;
+        }
+
+        /**
+         * @brief Pushes an item, blocking while the buffer is full
+         *
+         * @param item - The item to push
+         */
+        void pushWait(const T &item)
+            requires(!std::is_same_v<LockPolicy, NullLock>)
+        {
+            std::unique_lock<LockPolicy> lock = this->acquire();
+            m_waitingProducers++;
+            m_notFull.wait(lock, [this]()
+                           { return this->count() < m_capacity or this->canOverwrite(); });
+            m_waitingProducers--;
+            this->makeRoomForOne();
+            this->constructItem(item);
+            this->notifyConsumers(lock, 1);
+        }
+
+        /**
+         * @brief Pushes an item, blocking while the buffer is full for at most the given timeout
+         *
+         * @param item - The item to push
+         * @param timeout - The longest time to wait for a free slot
+         * @return bool - True if the item was pushed, false if the timeout expired first
+         */
+        template <typename Rep, typename Period>
+        bool pushFor(const T &item, const std::chrono::duration<Rep, Period> &timeout)
+            requires(!std::is_same_v<LockPolicy, NullLock>)
+        {
+            std::unique_lock<LockPolicy> lock = this->acquire();
+            m_waitingProducers++;
+            const bool hasSpace = m_notFull.wait_for(lock, timeout, [this]()
+                                                     { return this->count() < m_capacity or this->canOverwrite(); });
+            m_waitingProducers--;
+            if (!hasSpace)
+            {
+                m_stats.recordRejectedPush();
+                return false;
+            }
+            this->makeRoomForOne();
+            this->constructItem(item);
+            this->notifyConsumers(lock, 1);
+            return true;
+        }
+
+        /**
+         * @brief Pops an item, blocking while the buffer is empty
+         *
+         * @param item - Receives the popped item
+         */
+        void popWait(T &item)
+            requires(!std::is_same_v<LockPolicy, NullLock>)
+        {
+            std::unique_lock<LockPolicy> lock = this->acquire();
+            m_waitingConsumers++;
+            m_notEmpty.wait(lock, [this]()
+                            { return this->count() > 0; });
+            m_waitingConsumers--;
+            this->popItem(item);
+            this->notifyProducers(lock, 1);
+        }
+
+        /**
+         * @brief Pops an item, blocking while the buffer is empty for at most the given timeout
+         *
+         * @param item - Receives the popped item
+         * @param timeout - The longest time to wait for an item
+         * @return bool - True if an item was popped, false if the timeout expired first
+         */
+        template <typename Rep, typename Period>
+        bool popFor(T &item, const std::chrono::duration<Rep, Period> &timeout)
+            requires(!std::is_same_v<LockPolicy, NullLock>)
+        {
+            std::unique_lock<LockPolicy> lock = this->acquire();
+            m_waitingConsumers++;
+            const bool hasItem = m_notEmpty.wait_for(lock, timeout, [this]()
+                                                     { return this->count() > 0; });
+            m_waitingConsumers--;
+            if (!hasItem)
+            {
+                m_stats.recordFailedPop();
+                return false;
+            }
+            this->popItem(item);
+            this->notifyProducers(lock, 1);
+            return true;
+        }
+
+        /**
+         * @brief Awaitable pop for coroutines, use as `T item = co_await buffer.popAsync();`
+         *
+         * If the buffer is empty the awaiting coroutine is suspended without blocking its thread,
+         * and it is resumed on the thread whose push makes an item available. Waiting coroutines
+         * are served in the order they suspended.
+         *
+         * @note The buffer must outlive every coroutine suspended on it.
+         *
+         * @return PopAwaiter - An awaitable that produces the popped item
+         */
+        PopAwaiter popAsync()
+        {
+            return PopAwaiter(*this);
+        }
+
+        /**
+         * @brief Awaitable push for coroutines, use as `co_await buffer.pushAsync(item);`
+         *
+         * If the buffer is full the awaiting coroutine is suspended without blocking its thread,
+         * and it is resumed on the thread whose pop frees a slot for its item.
+         *
+         * @note The buffer must outlive every coroutine suspended on it.
+         *
+         * @param item - The item to push, held by the awaiter until there is room for it
+         * @return PushAwaiter - An awaitable that completes once the item is in the buffer
+         */
+        PushAwaiter pushAsync(T item)
+        {
+            return PushAwaiter(*this, std::move(item));
+        }
+
+        /**
+         * @brief Pushes as many items from a block as will fit, under a single lock
+         *
+         * With OverflowPolicy::OverwriteOldest the whole block is accepted and the oldest items,
+         * including the front of a block larger than the buffer, are dropped to make room.
+         *
+         * @param items - The items to push, oldest first
+         * @return uint32_t - The number of items pushed, from the front of the block
+         */
+        uint32_t pushN(std::span<const T> items)
+        {
+            std::unique_lock<LockPolicy> lock = this->acquire();
+            uint32_t skipped = 0;
+            if (this->canOverwrite())
+            {
+                if (items.size() > m_capacity)
+                {
+                    skipped = static_cast<uint32_t>(items.size()) - m_capacity;
+                    items = items.last(m_capacity);
+                }
+                const uint32_t freeSlots = m_capacity - this->count();
+                if (items.size() > freeSlots)
+                {
+                    const uint32_t dropped = static_cast<uint32_t>(items.size()) - freeSlots;
+                    this->destroyItems(m_head, dropped);
+                    this->advanceHead(dropped);
+                    m_overwritten += dropped;
+                }
+                m_overwritten += skipped;
+            }
+            const uint32_t count = std::min(static_cast<uint32_t>(items.size()), m_capacity - this->count());
+            this->copyIn(m_tail, items.first(count));
+            m_tail = this->advance(m_tail, count);
+            // Items skipped at the front of an oversized block count as pushed and then overwritten
+            m_stats.recordPush(count + skipped, this->count());
+            if (count < items.size())
+            {
+                m_stats.recordRejectedPush(static_cast<uint32_t>(items.size()) - count);
+            }
+            this->notifyConsumers(lock, count);
+            return count + skipped;
+        }
+
+        /**
+         * @brief Pops up to items.size() items into a block, under a single lock
+         *
+         * @param items - Receives the popped items, oldest first
+         * @return uint32_t - The number of items popped
+         */
+        uint32_t popN(std::span<T> items)
+        {
+            std::unique_lock<LockPolicy> lock = this->acquire();
+            const uint32_t count = std::min(static_cast<uint32_t>(items.size()), this->count());
+            this->moveOut(m_head, items.first(count));
+            this->advanceHead(count);
+            m_stats.recordPop(count);
+            if (count == 0 and !items.empty())
+            {
+                m_stats.recordFailedPop();
+            }
+            this->notifyProducers(lock, count);
+            return count;
+        }
+
+        /**
+         * @brief Copies up to items.size() items from the head without removing them
+         *
+         * @param items - Receives the copied items, oldest first
+         * @return uint32_t - The number of items copied
+         */
+        uint32_t peekN(std::span<T> items)
+        {
+            std::unique_lock<LockPolicy> lock = this->acquire();
+            const uint32_t count = std::min(static_cast<uint32_t>(items.size()), this->count());
+            this->copyOut(m_head, items.first(count));
+            return count;
+        }
+
+        /**
+         * @brief Reserves the contiguous free slots at the tail for writing in place
+         *
+         * The returned slots are not visible to consumers until they are published with commit().
+         * The span stops at the end of the storage, so it may be shorter than the total free space.
+         *
+         * @note Only one producer may hold a reservation at a time, and no other thread may push
+         * until it is committed. Only available for trivially copyable T, since the slots are raw
+         * storage until something is written to them.
+         *
+         * @return std::span<T> - The writable slots, empty if the buffer is full
+         */
+        std::span<T> reserve()
+            requires std::is_trivially_copyable_v<T>
+        {
+            std::unique_lock<LockPolicy> lock = this->acquire();
+            const uint32_t tail = this->slot(m_tail);
+            m_reserved = std::min(m_capacity - this->count(), m_capacity - tail);
+            return std::span<T>(&m_buffer[tail], m_reserved);
+        }
+
+        /**
+         * @brief Publishes the first count slots of the last reservation
+         *
+         * @param count - The number of slots written, from the front of the reservation
+         * @throws std::out_of_range - If count is larger than the reservation
+         */
+        void commit(uint32_t count)
+            requires std::is_trivially_copyable_v<T>
+        {
+            std::unique_lock<LockPolicy> lock = this->acquire();
+            if (count > m_reserved)
+            {
+                throw std::out_of_range("Commit exceeds reserved slots");
+            }
+            m_tail = this->advance(m_tail, count);
+            m_reserved = 0;
+            m_stats.recordPush(count, this->count());
+            this->notifyConsumers(lock, count);
+        }
+
+        /**
+         * @brief Returns the contiguous items at the head for reading in place
+         *
+         * The items stay in the buffer until they are handed back with release().
+         * The span stops at the end of the storage, so it may be shorter than size().
+         *
+         * @note Only one consumer may hold a peeked view at a time, and no other thread may pop
+         * until it is released. Only available for trivially copyable T, like reserve().
+         * Every non-empty view must be handed back with release(), release(0) if nothing was
+         * consumed: with OverflowPolicy::OverwriteOldest the buffer refuses to overwrite while
+         * items of the view are still in it.
+         *
+         * @return std::span<const T> - The readable items, empty if the buffer is empty
+         */
+        std::span<const T> peek()
+            requires std::is_trivially_copyable_v<T>
+        {
+            std::unique_lock<LockPolicy> lock = this->acquire();
+            const uint32_t head = this->slot(m_head);
+            m_peeked = std::min(this->count(), m_capacity - head);
+            return std::span<const T>(&m_buffer[head], m_peeked);
+        }
+
+        /**
+         * @brief Removes the first count items of the last peeked view
+         *
+         * @param count - The number of items consumed, from the front of the view
+         * @throws std::out_of_range - If count is larger than the peeked view
+         */
+        void release(uint32_t count)
+            requires std::is_trivially_copyable_v<T>
+        {
+            std::unique_lock<LockPolicy> lock = this->acquire();
+            if (count > m_peeked)
+            {
+                throw std::out_of_range("Release exceeds peeked items");
+            }
+            // A view that held back overwriting frees every producer once it is dropped, even
+            // when nothing was consumed
+            const bool overwriteResumed = m_peeked > 0 and m_overflowPolicy == OverflowPolicy::OverwriteOldest;
+            this->advanceHead(count);
+            m_peeked = 0;
+            m_stats.recordPop(count);
+            this->notifyProducers(lock, overwriteResumed ? m_capacity : count);
+        }
+
         uint32_t size()
         {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            return m_size;
+            std::unique_lock<LockPolicy> lock = this->acquire();
+            return this->count();
         }
 
         uint32_t capacity() const
@@ -55,18 +443,476 @@ namespace SHAMS
             return m_capacity;
         }
 
+        /**
+         * @brief Returns how many items have been dropped to make room under OverflowPolicy::OverwriteOldest
+         *
+         * @return uint64_t - The number of overwritten items since construction
+         */
+        uint64_t overwritten()
+        {
+            std::unique_lock<LockPolicy> lock = this->acquire();
+            return m_overwritten;
+        }
+
+        /**
+         * @brief Returns a snapshot of the traffic counters, all zero unless StatsPolicy is QueueStatsCounters
+         *
+         * Reading the counters does not take the lock, so the fields may come from slightly
+         * different moments while the buffer is in use.
+         *
+         * @return QueueStats - The counters since construction
+         */
+        QueueStats stats() const
+        {
+            return m_stats.snapshot();
+        }
+
         // bool operator bool() const
         // {
         //     return this->size() > 0;
         // }
 
     private:
-        std::unique_ptr<T[]> m_buffer;
-        std::mutex m_mutex;
+        // With stats enabled a failed try_lock is counted as contention before blocking
+        std::unique_lock<LockPolicy> acquire()
+        {
+            if constexpr (StatsPolicy::enabled)
+            {
+                std::unique_lock<LockPolicy> lock(m_lock, std::try_to_lock);
+                if (!lock.owns_lock())
+                {
+                    m_stats.recordContention();
+                    lock.lock();
+                }
+                return lock;
+            }
+            else
+            {
+                return std::unique_lock<LockPolicy>(m_lock);
+            }
+        }
+
+        // Items leaving the head also leave the peek() view, so a view that was never released
+        // stops blocking overwrites once its items have been popped
+        void advanceHead(uint32_t count)
+        {
+            m_head = this->advance(m_head, count);
+            m_peeked -= std::min(m_peeked, count);
+        }
+
+        template <typename... Args>
+        void constructItem(Args &&...args)
+        {
+            std::construct_at(&m_buffer[this->slot(m_tail)], std::forward<Args>(args)...);
+            m_tail = this->advance(m_tail, 1);
+            m_stats.recordPush(1, this->count());
+        }
+
+        // Overwriting is refused while a peek() view still covers items in the buffer, the
+        // consumer may still be reading the oldest slots in place
+        bool canOverwrite() const
+        {
+            return m_overflowPolicy == OverflowPolicy::OverwriteOldest and m_peeked == 0 and m_capacity > 0;
+        }
+
+        bool makeRoomForOne()
+        {
+            if (this->count() < m_capacity)
+            {
+                return true;
+            }
+            if (!this->canOverwrite())
+            {
+                return false;
+            }
+            this->destroyItems(m_head, 1);
+            this->advanceHead(1);
+            m_overwritten++;
+            return true;
+        }
+
+        void popItem(T &item)
+        {
+            T *head = &m_buffer[this->slot(m_head)];
+            item = std::move(*head);
+            std::destroy_at(head);
+            this->advanceHead(1);
+            m_stats.recordPop(1);
+        }
+
+        void destroyItems(uint32_t counter, uint32_t count)
+        {
+            if constexpr (!std::is_trivially_destructible_v<T>)
+            {
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    std::destroy_at(&m_buffer[this->slot(counter)]);
+                    counter = this->advance(counter, 1);
+                }
+            }
+        }
+
+        // Waiters are counted under the lock so the common no-waiter path skips the notify
+        // entirely, and the lock is dropped first so a woken thread does not block on it again.
+        // Suspended coroutines are handed their item under the lock and resumed after it.
+        void notifyConsumers(std::unique_lock<LockPolicy> &lock, uint32_t count)
+        {
+            if (count == 0 or (m_waitingConsumers == 0 and m_popAwaiters.empty()))
+            {
+                return;
+            }
+            Awaiter *ready = nullptr;
+            while (!m_popAwaiters.empty() and this->count() > 0)
+            {
+                PopAwaiter *awaiter = static_cast<PopAwaiter *>(m_popAwaiters.pop());
+                T *head = &m_buffer[this->slot(m_head)];
+                awaiter->m_item.emplace(std::move(*head));
+                std::destroy_at(head);
+                this->advanceHead(1);
+                m_stats.recordPop(1);
+                awaiter->m_next = ready;
+                ready = awaiter;
+            }
+            const bool wakeThreads = m_waitingConsumers > 0 and this->count() > 0;
+            lock.unlock();
+            if (wakeThreads)
+            {
+                if (count == 1)
+                {
+                    m_notEmpty.notify_one();
+                }
+                else
+                {
+                    m_notEmpty.notify_all();
+                }
+            }
+            Awaiter::resumeAll(ready);
+        }
+
+        void notifyProducers(std::unique_lock<LockPolicy> &lock, uint32_t count)
+        {
+            if (count == 0 or (m_waitingProducers == 0 and m_pushAwaiters.empty()))
+            {
+                return;
+            }
+            Awaiter *ready = nullptr;
+            while (!m_pushAwaiters.empty() and this->makeRoomForOne())
+            {
+                PushAwaiter *awaiter = static_cast<PushAwaiter *>(m_pushAwaiters.pop());
+                this->constructItem(std::move(awaiter->m_item));
+                awaiter->m_next = ready;
+                ready = awaiter;
+            }
+            const bool wakeThreads = m_waitingProducers > 0 and (this->count() < m_capacity or this->canOverwrite());
+            lock.unlock();
+            if (wakeThreads)
+            {
+                if (count == 1)
+                {
+                    m_notFull.notify_one();
+                }
+                else
+                {
+                    m_notFull.notify_all();
+                }
+            }
+            Awaiter::resumeAll(ready);
+        }
+
+        // Suspended coroutines wait in intrusive FIFO lists, the awaiters live in their coroutine frames
+        class Awaiter
+        {
+        public:
+            static void resumeAll(Awaiter *ready)
+            {
+                // Resuming may destroy the awaiter, so its link is read first. The list was
+                // built newest first, reverse it so coroutines resume in the order they waited.
+                Awaiter *ordered = nullptr;
+                while (ready != nullptr)
+                {
+                    Awaiter *next = ready->m_next;
+                    ready->m_next = ordered;
+                    ordered = ready;
+                    ready = next;
+                }
+                while (ordered != nullptr)
+                {
+                    Awaiter *next = ordered->m_next;
+                    ordered->m_handle.resume();
+                    ordered = next;
+                }
+            }
+
+            std::coroutine_handle<> m_handle;
+            Awaiter *m_next = nullptr;
+        };
+
+        class AwaiterQueue
+        {
+        public:
+            bool empty() const
+            {
+                return m_first == nullptr;
+            }
+
+            void push(Awaiter *awaiter)
+            {
+                awaiter->m_next = nullptr;
+                if (m_last == nullptr)
+                {
+                    m_first = awaiter;
+                }
+                else
+                {
+                    m_last->m_next = awaiter;
+                }
+                m_last = awaiter;
+            }
+
+            Awaiter *pop()
+            {
+                Awaiter *awaiter = m_first;
+                m_first = awaiter->m_next;
+                if (m_first == nullptr)
+                {
+                    m_last = nullptr;
+                }
+                return awaiter;
+            }
+
+        private:
+            Awaiter *m_first = nullptr;
+            Awaiter *m_last = nullptr;
+        };
+
+        class PopAwaiter : public Awaiter
+        {
+        public:
+            explicit PopAwaiter(RingBuffer &buffer)
+                : m_buffer(buffer)
+            {
+            }
+
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            // Checking and queueing happen under one lock, so a push cannot slip in between
+            bool await_suspend(std::coroutine_handle<> handle)
+            {
+                std::unique_lock<LockPolicy> lock = m_buffer.acquire();
+                if (m_buffer.count() > 0)
+                {
+                    T *head = &m_buffer.m_buffer[m_buffer.slot(m_buffer.m_head)];
+                    m_item.emplace(std::move(*head));
+                    std::destroy_at(head);
+                    m_buffer.advanceHead(1);
+                    m_buffer.m_stats.recordPop(1);
+                    m_buffer.notifyProducers(lock, 1);
+                    return false;
+                }
+                this->m_handle = handle;
+                m_buffer.m_popAwaiters.push(this);
+                return true;
+            }
+
+            T await_resume()
+            {
+                return std::move(*m_item);
+            }
+
+        private:
+            friend class RingBuffer;
+
+            RingBuffer &m_buffer;
+            std::optional<T> m_item;
+        };
+
+        class PushAwaiter : public Awaiter
+        {
+        public:
+            PushAwaiter(RingBuffer &buffer, T item)
+                : m_buffer(buffer),
+                  m_item(std::move(item))
+            {
+            }
+
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            bool await_suspend(std::coroutine_handle<> handle)
+            {
+                std::unique_lock<LockPolicy> lock = m_buffer.acquire();
+                if (m_buffer.makeRoomForOne())
+                {
+                    m_buffer.constructItem(std::move(m_item));
+                    m_buffer.notifyConsumers(lock, 1);
+                    return false;
+                }
+                this->m_handle = handle;
+                m_buffer.m_pushAwaiters.push(this);
+                return true;
+            }
+
+            void await_resume() const noexcept
+            {
+            }
+
+        private:
+            friend class RingBuffer;
+
+            RingBuffer &m_buffer;
+            T m_item;
+        };
+
+        // Head and tail are counters rather than slot indices, so full and empty are told apart
+        // without a separate size field. With a power-of-two capacity they run freely and wrap
+        // at 2^32, a multiple of the capacity; otherwise they wrap at twice the capacity.
+        uint32_t advance(uint32_t counter, uint32_t count) const
+        {
+            counter += count;
+            if (m_powerOfTwo)
+            {
+                return counter;
+            }
+            return (counter >= 2 * m_capacity) ? counter - 2 * m_capacity : counter;
+        }
+
+        uint32_t slot(uint32_t counter) const
+        {
+            if (m_powerOfTwo)
+            {
+                return counter & (m_capacity - 1);
+            }
+            return (counter >= m_capacity) ? counter - m_capacity : counter;
+        }
+
+        uint32_t count() const
+        {
+            if (m_powerOfTwo or m_tail >= m_head)
+            {
+                return m_tail - m_head;
+            }
+            return m_tail + 2 * m_capacity - m_head;
+        }
+
+        // A block wraps at most once, so it is copied as at most two contiguous segments
+        void copyIn(uint32_t counter, std::span<const T> items)
+        {
+            const uint32_t start = this->slot(counter);
+            const uint32_t first = std::min(static_cast<uint32_t>(items.size()), m_capacity - start);
+            constructSegment(&m_buffer[start], items.data(), first);
+            constructSegment(&m_buffer[0], items.data() + first, static_cast<uint32_t>(items.size()) - first);
+        }
+
+        void copyOut(uint32_t counter, std::span<T> items) const
+        {
+            const uint32_t start = this->slot(counter);
+            const uint32_t first = std::min(static_cast<uint32_t>(items.size()), m_capacity - start);
+            copySegment(items.data(), &m_buffer[start], first);
+            copySegment(items.data() + first, &m_buffer[0], static_cast<uint32_t>(items.size()) - first);
+        }
+
+        void moveOut(uint32_t counter, std::span<T> items)
+        {
+            const uint32_t start = this->slot(counter);
+            const uint32_t first = std::min(static_cast<uint32_t>(items.size()), m_capacity - start);
+            moveSegment(items.data(), &m_buffer[start], first);
+            moveSegment(items.data() + first, &m_buffer[0], static_cast<uint32_t>(items.size()) - first);
+        }
+
+        // Copies into raw slots
+        static void constructSegment(T *destination, const T *source, uint32_t count)
+        {
+            if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                if (count > 0)
+                {
+                    std::memcpy(destination, source, count * sizeof(T));
+                }
+            }
+            else
+            {
+                std::uninitialized_copy(source, source + count, destination);
+            }
+        }
+
+        // Copies out of live slots into live items
+        static void copySegment(T *destination, const T *source, uint32_t count)
+        {
+            if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                if (count > 0)
+                {
+                    std::memcpy(destination, source, count * sizeof(T));
+                }
+            }
+            else
+            {
+                std::copy(source, source + count, destination);
+            }
+        }
+
+        // Moves out of live slots into live items, leaving the slots raw
+        static void moveSegment(T *destination, T *source, uint32_t count)
+        {
+            if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                if (count > 0)
+                {
+                    std::memcpy(destination, source, count * sizeof(T));
+                }
+            }
+            else
+            {
+                std::move(source, source + count, destination);
+                std::destroy(source, source + count);
+            }
+        }
+
+        // Nothing can wait on a NullLock buffer, so it needs no condition variables at all
+        struct NoConditionVariable
+        {
+            void notify_one() {}
+            void notify_all() {}
+        };
+
+        // std::condition_variable only works with std::mutex, any other lock needs the generic one
+        using ConditionVariable = std::conditional_t<std::is_same_v<LockPolicy, NullLock>, NoConditionVariable,
+                                                     std::conditional_t<std::is_same_v<LockPolicy, std::mutex>, std::condition_variable, std::condition_variable_any>>;
+
+        // Slots are allocated raw, items are constructed on push and destroyed on pop
+        struct StorageDeleter
+        {
+            uint32_t capacity;
+
+            void operator()(T *storage) const
+            {
+                std::allocator<T>().deallocate(storage, capacity);
+            }
+        };
+
+    private:
+        const uint32_t m_capacity;
+        const bool m_powerOfTwo;
+        const OverflowPolicy m_overflowPolicy;
+        std::unique_ptr<T[], StorageDeleter> m_buffer;
+        LockPolicy m_lock;
+        [[no_unique_address]] ConditionVariable m_notEmpty;
+        [[no_unique_address]] ConditionVariable m_notFull;
+        uint32_t m_waitingConsumers = 0;
+        uint32_t m_waitingProducers = 0;
+        AwaiterQueue m_popAwaiters;
+        AwaiterQueue m_pushAwaiters;
         uint32_t m_head = 0;
         uint32_t m_tail = 0;
-        uint32_t m_size = 0;
-        const uint32_t m_capacity;
+        uint32_t m_reserved = 0;
+        uint32_t m_peeked = 0;
+        uint64_t m_overwritten = 0;
+        [[no_unique_address]] StatsPolicy m_stats;
     };
 
 } // namespace SHAMS
@@ -0,0 +1,250 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "ShamsHashing.hpp"
+
+namespace SHAMS
+{
+    /**
+     * @brief Robin Hood placement and control-byte probing shared by Dictionary and StaticDictionary
+     *
+     * The derived table owns the storage and this base only implements the algorithms on it,
+     * so a heap-allocated and an in-object table probe, insert and remove in exactly the same
+     * way. The derived table provides, for the base to call:
+     * - slotCount() and maxCapacity()
+     * - controls(), slotCount() + k_mirroredControls control bytes
+     * - distances(), one probe distance per slot, 0 for an empty slot
+     * - keyAt(index) and valueAt(index), references to a slot's key and value
+     * - markOccupied(index, occupied), called whenever a slot is filled or emptied
+     *
+     * Lookups report a missing key as index slotCount().
+     *
+     * @tparam Derived - The table built on this base
+     * @tparam key_type - The key type
+     * @tparam value_type - The value type
+     * @tparam Hash - The hash function for key_type
+     * @tparam Equal - The key comparison, must agree with Hash
+     */
+    template <typename Derived, typename key_type, typename value_type, typename Hash, typename Equal>
+    class RobinHoodTable
+    {
+    protected:
+        static constexpr uint8_t k_emptyControl = 0x80;
+        static constexpr uint32_t k_groupSize = 16;
+        // The first slots' control bytes are repeated after the last, so a group read never wraps
+        static constexpr uint32_t k_mirroredControls = k_groupSize - 1;
+
+        // The slot index comes from the high half of the mixed hash and the control byte from
+        // bits below it, so keys sharing a probe window do not share control bytes as well
+        uint32_t homeIndex(uint64_t hash) const
+        {
+            return reduceRange(static_cast<uint32_t>(hash >> 32), this->derived().slotCount());
+        }
+
+        static uint8_t controlByte(uint64_t hash)
+        {
+            return static_cast<uint8_t>((hash >> 25) & 0x7F);
+        }
+
+        uint32_t nextIndex(uint32_t index) const
+        {
+            return (index + 1 == this->derived().slotCount()) ? 0 : index + 1;
+        }
+
+        uint32_t wrapIndex(uint32_t index) const
+        {
+            const uint32_t slotCount = this->derived().slotCount();
+            return (index >= slotCount) ? index - slotCount : index;
+        }
+
+        void setControl(uint32_t index, uint8_t control)
+        {
+            const uint32_t slotCount = this->derived().slotCount();
+            uint8_t *controls = this->derived().controls();
+            for (uint32_t mirror = index; mirror < slotCount + k_mirroredControls; mirror += slotCount)
+            {
+                controls[mirror] = control;
+            }
+        }
+
+        // Robin Hood never lets a key sit past an empty slot or further than the longest
+        // distance ever placed, so the probe stops at whichever comes first
+        template <typename Lookup>
+        uint32_t findIndex(const Lookup &key) const
+        {
+            return this->findIndex(key, mixHash(Hash{}(key)));
+        }
+
+        template <typename Lookup>
+        uint32_t findIndex(const Lookup &key, uint64_t hash) const
+        {
+            const Derived &table = this->derived();
+            const uint8_t *controls = table.controls();
+            const uint8_t control = controlByte(hash);
+            uint32_t index = this->homeIndex(hash);
+            for (uint32_t probed = 0; probed < m_maxDistance; probed += k_groupSize)
+            {
+                const uint32_t remaining = m_maxDistance - probed;
+                const uint32_t inRange = (remaining >= k_groupSize) ? 0xFFFF : (1u << remaining) - 1;
+                const uint32_t empty = matchControlGroup(&controls[index], k_emptyControl) & inRange;
+                uint32_t matches = matchControlGroup(&controls[index], control) & inRange;
+                if (empty != 0)
+                {
+                    matches &= (empty & (0 - empty)) - 1;
+                }
+                while (matches != 0)
+                {
+                    const uint32_t slot = this->wrapIndex(index + static_cast<uint32_t>(std::countr_zero(matches)));
+                    if (Equal{}(table.keyAt(slot), key))
+                    {
+                        return slot;
+                    }
+                    matches &= matches - 1;
+                }
+                if (empty != 0)
+                {
+                    break;
+                }
+                index = this->wrapIndex(index + k_groupSize);
+            }
+            return table.slotCount();
+        }
+
+        // One probe both finds an existing key and the slot a new one belongs in: Robin Hood
+        // keeps a key in front of the first slot whose resident is closer to home than it.
+        // Returns the key's slot, slotCount() if the table is full, and whether it was inserted.
+        template <typename Lookup, typename... Args>
+        std::pair<uint32_t, bool> emplaceItem(const Lookup &key, Args &&...args)
+        {
+            Derived &table = this->derived();
+            auto *distances = table.distances();
+            using Distance = std::remove_pointer_t<decltype(distances)>;
+
+            const uint64_t hash = mixHash(Hash{}(key));
+            const uint8_t control = controlByte(hash);
+            uint32_t distance = 1;
+            uint32_t index = this->homeIndex(hash);
+            while (distances[index] >= distance)
+            {
+                if (distances[index] == distance and table.controls()[index] == control and Equal{}(table.keyAt(index), key))
+                {
+                    return {index, false};
+                }
+                index = this->nextIndex(index);
+                distance++;
+            }
+
+            // Check if the table is full
+            if (m_size == table.maxCapacity())
+            {
+                return {table.slotCount(), false};
+            }
+
+            const uint32_t inserted = index;
+            key_type carriedKey(key);
+            value_type carriedValue(std::forward<Args>(args)...);
+            uint8_t carriedControl = control;
+            while (distances[index] != 0)
+            {
+                if (distances[index] < distance)
+                {
+                    const uint8_t residentControl = table.controls()[index];
+                    const uint32_t residentDistance = distances[index];
+                    std::swap(carriedKey, table.keyAt(index));
+                    std::swap(carriedValue, table.valueAt(index));
+                    distances[index] = static_cast<Distance>(distance);
+                    this->setControl(index, carriedControl);
+                    m_maxDistance = std::max(m_maxDistance, distance);
+                    carriedControl = residentControl;
+                    distance = residentDistance;
+                }
+                index = this->nextIndex(index);
+                distance++;
+            }
+            table.keyAt(index) = std::move(carriedKey);
+            table.valueAt(index) = std::move(carriedValue);
+            distances[index] = static_cast<Distance>(distance);
+            this->setControl(index, carriedControl);
+            table.markOccupied(index, true);
+            m_maxDistance = std::max(m_maxDistance, distance);
+            m_size++;
+            return {inserted, true};
+        }
+
+        template <typename Lookup>
+        bool removeItem(const Lookup &key)
+        {
+            uint32_t index = this->findIndex(key);
+            Derived &table = this->derived();
+            if (index == table.slotCount())
+            {
+                return false;
+            }
+
+            // Pull the rest of the cluster one slot closer to home until an empty slot or a key already at home
+            auto *distances = table.distances();
+            using Distance = std::remove_pointer_t<decltype(distances)>;
+            uint32_t next = this->nextIndex(index);
+            while (distances[next] > 1)
+            {
+                table.keyAt(index) = std::move(table.keyAt(next));
+                table.valueAt(index) = std::move(table.valueAt(next));
+                distances[index] = static_cast<Distance>(distances[next] - 1);
+                this->setControl(index, table.controls()[next]);
+                index = next;
+                next = this->nextIndex(next);
+            }
+            table.keyAt(index) = key_type();
+            table.valueAt(index) = value_type();
+            distances[index] = 0;
+            this->setControl(index, k_emptyControl);
+            table.markOccupied(index, false);
+            m_size--;
+            if (m_size == 0)
+            {
+                m_maxDistance = 0;
+            }
+            return true;
+        }
+
+        template <typename Lookup>
+        value_type *findValue(const Lookup &key)
+        {
+            const uint32_t index = this->findIndex(key);
+            return (index == this->derived().slotCount()) ? nullptr : &this->derived().valueAt(index);
+        }
+
+        template <typename Lookup>
+        value_type &getValue(const Lookup &key)
+        {
+            value_type *value = this->findValue(key);
+            if (value == nullptr)
+            {
+                throw std::out_of_range("Key not found");
+            }
+            return *value;
+        }
+
+    private:
+        Derived &derived()
+        {
+            return static_cast<Derived &>(*this);
+        }
+
+        const Derived &derived() const
+        {
+            return static_cast<const Derived &>(*this);
+        }
+
+    protected:
+        uint32_t m_size = 0;
+        uint32_t m_maxDistance = 0;
+    };
+
+} // namespace SHAMS
@@ -0,0 +1,252 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+
+namespace SHAMS
+{
+    /**
+     * @brief Unbounded queue built from a chain of fixed-size segments
+     *
+     * Items are stored in segments of segmentSize slots linked in FIFO order. When the tail
+     * segment fills, the queue links another one, taken from a pool of recycled segments before
+     * anything is allocated. When the head segment drains it goes back to the pool, and segments
+     * beyond the pool limit are freed. Steady-state memory stays at a couple of segments, while a
+     * burst grows the chain instead of failing the push.
+     *
+     * @note Thread-safe, every operation takes the queue's mutex.
+     */
+    template <typename T>
+    class SegmentedQueue
+    {
+    public:
+        /**
+         * @brief Constructs the queue
+         *
+         * @param segmentSize - The number of items per segment
+         * @param maxPooledSegments - The number of drained segments kept for reuse instead of being freed
+         * @throws std::invalid_argument - If segmentSize is zero
+         */
+        SegmentedQueue(uint32_t segmentSize, uint32_t maxPooledSegments = 2)
+            : m_segmentSize(segmentSize),
+              m_maxPooledSegments(maxPooledSegments)
+        {
+            if (segmentSize == 0)
+            {
+                throw std::invalid_argument("Segment size must be greater than zero");
+            }
+        }
+
+        SegmentedQueue(const SegmentedQueue &) = delete;
+        SegmentedQueue &operator=(const SegmentedQueue &) = delete;
+
+        ~SegmentedQueue()
+        {
+            while (m_first != nullptr)
+            {
+                Segment *next = m_first->next;
+                std::destroy(m_first->items + m_first->head, m_first->items + m_first->tail);
+                this->freeSegment(m_first);
+                m_first = next;
+            }
+            while (m_pool != nullptr)
+            {
+                Segment *next = m_pool->next;
+                this->freeSegment(m_pool);
+                m_pool = next;
+            }
+        }
+
+        /**
+         * @brief Pushes an item onto the tail of the queue, linking a new segment if needed
+         *
+         * @param item - The item to push
+         * @return bool - Always true, the queue grows instead of rejecting
+         */
+        bool push(const T &item)
+        {
+            return this->emplace(item);
+        }
+
+        bool push(T &&item)
+        {
+            return this->emplace(std::move(item));
+        }
+
+        /**
+         * @brief Constructs an item in place at the tail of the queue
+         *
+         * @param args - The arguments forwarded to the constructor of T
+         * @throws std::bad_alloc - If a new segment is needed and cannot be allocated
+         * @return bool - Always true, the queue grows instead of rejecting
+         */
+        template <typename... Args>
+        bool emplace(Args &&...args)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_last == nullptr or m_last->tail == m_segmentSize)
+            {
+                this->linkSegment();
+            }
+            std::construct_at(m_last->items + m_last->tail, std::forward<Args>(args)...);
+            m_last->tail++;
+            m_size++;
+            return true;
+        }
+
+        /**
+         * @brief Moves the item at the head of the queue out
+         *
+         * @param item - Receives the popped item
+         * @return bool - True if an item was popped, false if the queue is empty
+         */
+        bool pop(T &item)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_size == 0)
+            {
+                return false;
+            }
+            T *head = m_first->items + m_first->head;
+            item = std::move(*head);
+            std::destroy_at(head);
+            this->advanceHead();
+            return true;
+        }
+
+        /**
+         * @brief Moves the item at the head of the queue out
+         *
+         * @return std::optional<T> - The popped item, empty if the queue is empty
+         */
+        std::optional<T> pop()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_size == 0)
+            {
+                return std::nullopt;
+            }
+            T *head = m_first->items + m_first->head;
+            std::optional<T> item(std::move(*head));
+            std::destroy_at(head);
+            this->advanceHead();
+            return item;
+        }
+
+        uint32_t size() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_size;
+        }
+
+        /**
+         * @brief Returns the number of segments currently allocated, linked or pooled
+         *
+         * @return uint32_t - The number of segments
+         */
+        uint32_t segments() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_segmentCount;
+        }
+
+    private:
+        struct Segment
+        {
+            T *items = nullptr;
+            uint32_t head = 0;
+            uint32_t tail = 0;
+            Segment *next = nullptr;
+        };
+
+        void linkSegment()
+        {
+            Segment *segment = m_pool;
+            if (segment != nullptr)
+            {
+                m_pool = segment->next;
+                m_pooledSegments--;
+            }
+            else
+            {
+                auto fresh = std::make_unique<Segment>();
+                fresh->items = std::allocator<T>().allocate(m_segmentSize);
+                segment = fresh.release();
+                m_segmentCount++;
+            }
+            segment->head = 0;
+            segment->tail = 0;
+            segment->next = nullptr;
+
+            if (m_last == nullptr)
+            {
+                m_first = segment;
+            }
+            else
+            {
+                m_last->next = segment;
+            }
+            m_last = segment;
+        }
+
+        void advanceHead()
+        {
+            m_first->head++;
+            m_size--;
+            if (m_first->head < m_first->tail)
+            {
+                return;
+            }
+            if (m_first == m_last)
+            {
+                // Drained but still the tail, rewind it in place rather than cycling the pool
+                m_first->head = 0;
+                m_first->tail = 0;
+                return;
+            }
+            if (m_first->head == m_segmentSize)
+            {
+                Segment *drained = m_first;
+                m_first = drained->next;
+                this->recycleSegment(drained);
+            }
+        }
+
+        void recycleSegment(Segment *segment)
+        {
+            if (m_pooledSegments < m_maxPooledSegments)
+            {
+                segment->next = m_pool;
+                m_pool = segment;
+                m_pooledSegments++;
+            }
+            else
+            {
+                this->freeSegment(segment);
+                m_segmentCount--;
+            }
+        }
+
+        void freeSegment(Segment *segment)
+        {
+            std::allocator<T>().deallocate(segment->items, m_segmentSize);
+            delete segment;
+        }
+
+    private:
+        const uint32_t m_segmentSize;
+        const uint32_t m_maxPooledSegments;
+        mutable std::mutex m_mutex;
+        Segment *m_first = nullptr;
+        Segment *m_last = nullptr;
+        Segment *m_pool = nullptr;
+        uint32_t m_pooledSegments = 0;
+        uint32_t m_segmentCount = 0;
+        uint32_t m_size = 0;
+    };
+
+} // namespace SHAMS
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace SHAMS
+{
+    /**
+     * @brief Single-producer/single-consumer ring buffer shared between two processes
+     *
+     * The header and the slots live in a POSIX shared memory segment. Head and tail are slot
+     * indices rather than pointers, so each process can map the segment at a different address,
+     * and they are lock-free atomics, so push and pop never make a system call. One process
+     * creates the segment with the capacity constructor, the other attaches to it by name.
+     *
+     * @note Linux/POSIX only. Exactly one process may push and exactly one process may pop.
+     *
+     * @tparam T - The item type, must be trivially copyable since it is shared as raw bytes
+     */
+    template <typename T>
+    class SharedMemoryRingBuffer
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "SharedMemoryRingBuffer items must be trivially copyable");
+        static_assert(std::atomic<uint32_t>::is_always_lock_free, "Shared indices must be lock-free to work across processes");
+
+    public:
+        /**
+         * @brief Creates a new shared memory segment and the ring buffer inside it
+         *
+         * The segment is unlinked again when this object is destroyed.
+         *
+         * @param name - The POSIX shared memory name, starting with '/'
+         * @param capacity - The number of items the buffer can hold
+         * @throws std::runtime_error - If the segment already exists or cannot be created
+         */
+        SharedMemoryRingBuffer(const std::string &name, uint32_t capacity)
+            : m_name(name),
+              m_owner(true)
+        {
+            if (capacity == 0)
+            {
+                throw std::invalid_argument("Capacity must be greater than zero");
+            }
+
+            m_mappedSize = mappedSize(capacity + 1);
+            const int fd = shm_open(m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            if (fd < 0)
+            {
+                throw std::runtime_error("Unable to create shared memory segment " + m_name);
+            }
+            if (ftruncate(fd, static_cast<off_t>(m_mappedSize)) != 0)
+            {
+                close(fd);
+                shm_unlink(m_name.c_str());
+                throw std::runtime_error("Unable to size shared memory segment " + m_name);
+            }
+            this->map(fd);
+
+            m_header = new (m_mapping) Header{};
+            m_header->slots = capacity + 1;
+            m_header->itemSize = sizeof(T);
+            m_header->magic.store(k_magic, std::memory_order_release);
+            m_slots = m_header->slots;
+        }
+
+        /**
+         * @brief Attaches to a ring buffer created by another process
+         *
+         * @param name - The POSIX shared memory name the buffer was created with
+         * @throws std::runtime_error - If the segment does not exist or holds a different item type
+         */
+        explicit SharedMemoryRingBuffer(const std::string &name)
+            : m_name(name),
+              m_owner(false)
+        {
+            const int fd = shm_open(m_name.c_str(), O_RDWR, 0600);
+            if (fd < 0)
+            {
+                throw std::runtime_error("Unable to open shared memory segment " + m_name);
+            }
+            struct stat status{};
+            if (fstat(fd, &status) != 0 or static_cast<size_t>(status.st_size) < sizeof(Header))
+            {
+                close(fd);
+                throw std::runtime_error("Shared memory segment " + m_name + " is not a ring buffer");
+            }
+            m_mappedSize = static_cast<size_t>(status.st_size);
+            this->map(fd);
+
+            m_header = std::launder(reinterpret_cast<Header *>(m_mapping));
+            if (m_header->magic.load(std::memory_order_acquire) != k_magic or
+                m_header->itemSize != sizeof(T) or
+                mappedSize(m_header->slots) > m_mappedSize)
+            {
+                munmap(m_mapping, m_mappedSize);
+                throw std::runtime_error("Shared memory segment " + m_name + " is not a ring buffer of this type");
+            }
+            m_slots = m_header->slots;
+            // The segment may already have been used, so the cached indices start from the shared ones
+            m_cachedHead = m_header->head.load(std::memory_order_acquire);
+            m_cachedTail = m_header->tail.load(std::memory_order_acquire);
+        }
+
+        SharedMemoryRingBuffer(const SharedMemoryRingBuffer &) = delete;
+        SharedMemoryRingBuffer &operator=(const SharedMemoryRingBuffer &) = delete;
+
+        ~SharedMemoryRingBuffer()
+        {
+            munmap(m_mapping, m_mappedSize);
+            if (m_owner)
+            {
+                shm_unlink(m_name.c_str());
+            }
+        }
+
+        /**
+         * @brief Pushes an item onto the tail of the buffer, producer process only
+         *
+         * @param item - The item to push
+         * @return bool - True if the item was pushed, false if the buffer is full
+         */
+        bool push(const T &item)
+        {
+            const uint32_t tail = m_header->tail.load(std::memory_order_relaxed);
+            const uint32_t nextTail = this->next(tail);
+            if (nextTail == m_cachedHead)
+            {
+                m_cachedHead = m_header->head.load(std::memory_order_acquire);
+                if (nextTail == m_cachedHead)
+                {
+                    return false;
+                }
+            }
+            std::memcpy(this->slot(tail), &item, sizeof(T));
+            m_header->tail.store(nextTail, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Pops an item from the head of the buffer, consumer process only
+         *
+         * @param item - Receives the popped item
+         * @return bool - True if an item was popped, false if the buffer is empty
+         */
+        bool pop(T &item)
+        {
+            const uint32_t head = m_header->head.load(std::memory_order_relaxed);
+            if (head == m_cachedTail)
+            {
+                m_cachedTail = m_header->tail.load(std::memory_order_acquire);
+                if (head == m_cachedTail)
+                {
+                    return false;
+                }
+            }
+            std::memcpy(&item, this->slot(head), sizeof(T));
+            m_header->head.store(this->next(head), std::memory_order_release);
+            return true;
+        }
+
+        uint32_t size() const
+        {
+            const uint32_t head = m_header->head.load(std::memory_order_acquire);
+            const uint32_t tail = m_header->tail.load(std::memory_order_acquire);
+            return (tail >= head) ? (tail - head) : (tail + m_slots - head);
+        }
+
+        uint32_t capacity() const
+        {
+            return m_slots - 1;
+        }
+
+    private:
+        static constexpr uint32_t k_magic = 0x53524E47; // "SRNG"
+        static constexpr size_t k_cacheLineSize = 64;
+
+        // Everything in here is shared, so it holds indices and sizes only, never pointers
+        struct Header
+        {
+            std::atomic<uint32_t> magic = 0;
+            uint32_t slots = 0;
+            uint32_t itemSize = 0;
+            alignas(k_cacheLineSize) std::atomic<uint32_t> head = 0;
+            alignas(k_cacheLineSize) std::atomic<uint32_t> tail = 0;
+        };
+
+        static constexpr size_t k_slotsOffset = (sizeof(Header) + alignof(T) - 1) / alignof(T) * alignof(T);
+
+        static size_t mappedSize(uint32_t slots)
+        {
+            return k_slotsOffset + static_cast<size_t>(slots) * sizeof(T);
+        }
+
+        void map(int fd)
+        {
+            void *mapping = mmap(nullptr, m_mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close(fd);
+            if (mapping == MAP_FAILED)
+            {
+                if (m_owner)
+                {
+                    shm_unlink(m_name.c_str());
+                }
+                throw std::runtime_error("Unable to map shared memory segment " + m_name);
+            }
+            m_mapping = static_cast<std::byte *>(mapping);
+        }
+
+        std::byte *slot(uint32_t index) const
+        {
+            return m_mapping + k_slotsOffset + static_cast<size_t>(index) * sizeof(T);
+        }
+
+        uint32_t next(uint32_t index) const
+        {
+            return (index + 1 == m_slots) ? 0 : index + 1;
+        }
+
+    private:
+        std::string m_name;
+        const bool m_owner;
+        size_t m_mappedSize = 0;
+        std::byte *m_mapping = nullptr;
+        Header *m_header = nullptr;
+        uint32_t m_slots = 0;
+        // Process-local copies of the other side's index, refreshed only when the buffer looks full or empty
+        uint32_t m_cachedHead = 0;
+        uint32_t m_cachedTail = 0;
+    };
+
+} // namespace SHAMS
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+#include "ShamsQueueStats.hpp"
+
+namespace SHAMS
+{
+    /**
+     * @brief Lock-free ring buffer for exactly one producer thread and one consumer thread
+     *
+     * Offers the same push/pop/size/capacity interface as SHAMS::RingBuffer<T> without taking
+     * a lock. The producer owns the tail index and the consumer owns the head index; each lives
+     * on its own cache line together with a cached copy of the other side's index, so the
+     * indices only cross cores when the cached view says the buffer is full or empty.
+     *
+     * @note Calling push from more than one thread, or pop from more than one thread, is undefined.
+     *
+     * @tparam T - The item type
+     * @tparam StatsPolicy - QueueStatsCounters to collect traffic counters for stats(), NoQueueStats to compile them out
+     */
+    template <typename T, typename StatsPolicy = NoQueueStats>
+    class SpscRingBuffer
+    {
+    public:
+        SpscRingBuffer(uint32_t capacity)
+            : m_buffer(std::make_unique<T[]>(capacity + 1)),
+              m_slots(capacity + 1)
+        {
+            if (capacity == 0)
+            {
+                throw std::invalid_argument("Capacity must be greater than zero");
+            }
+        }
+
+        /**
+         * @brief Pushes an item onto the tail of the buffer, producer thread only
+         *
+         * @param item - The item to push
+         * @return bool - True if the item was pushed, false if the buffer is full
+         */
+        bool push(const T &item)
+        {
+            const uint32_t tail = m_producer.index.load(std::memory_order_relaxed);
+            const uint32_t nextTail = this->next(tail);
+            if (nextTail == m_producer.cachedOther)
+            {
+                m_producer.cachedOther = m_consumer.index.load(std::memory_order_acquire);
+                if (nextTail == m_producer.cachedOther)
+                {
+                    m_stats.recordRejectedPush();
+                    return false;
+                }
+            }
+            m_buffer[tail] = item;
+            m_producer.index.store(nextTail, std::memory_order_release);
+            m_stats.recordPush(1, this->distance(m_producer.cachedOther, nextTail));
+            return true;
+        }
+
+        /**
+         * @brief Pops an item from the head of the buffer, consumer thread only
+         *
+         * @param item - Receives the popped item
+         * @return bool - True if an item was popped, false if the buffer is empty
+         */
+        bool pop(T &item)
+        {
+            const uint32_t head = m_consumer.index.load(std::memory_order_relaxed);
+            if (head == m_consumer.cachedOther)
+            {
+                m_consumer.cachedOther = m_producer.index.load(std::memory_order_acquire);
+                if (head == m_consumer.cachedOther)
+                {
+                    m_stats.recordFailedPop();
+                    return false;
+                }
+            }
+            item = m_buffer[head];
+            m_consumer.index.store(this->next(head), std::memory_order_release);
+            m_stats.recordPop(1);
+            return true;
+        }
+
+        /**
+         * @brief Returns the number of items in the buffer
+         *
+         * @note Exact only when called from the producer or consumer thread; from any other
+         * thread the value is a snapshot that may already be stale.
+         *
+         * @return uint32_t - The number of items in the buffer
+         */
+        uint32_t size() const
+        {
+            const uint32_t head = m_consumer.index.load(std::memory_order_acquire);
+            const uint32_t tail = m_producer.index.load(std::memory_order_acquire);
+            return this->distance(head, tail);
+        }
+
+        uint32_t capacity() const
+        {
+            return m_slots - 1;
+        }
+
+        /**
+         * @brief Returns a snapshot of the traffic counters, all zero unless StatsPolicy is QueueStatsCounters
+         *
+         * peakSize is measured against the producer's cached head, so it never adds a read of
+         * the consumer's cache line to push() and may run slightly above the true peak.
+         *
+         * @return QueueStats - The counters since construction, contendedLocks is always zero
+         */
+        QueueStats stats() const
+        {
+            return m_stats.snapshot();
+        }
+
+    private:
+        uint32_t next(uint32_t index) const
+        {
+            // Compare instead of modulo, keeps the integer divide off the hot path
+            return (index + 1 == m_slots) ? 0 : index + 1;
+        }
+
+        uint32_t distance(uint32_t head, uint32_t tail) const
+        {
+            return (tail >= head) ? (tail - head) : (tail + m_slots - head);
+        }
+
+        static constexpr size_t k_cacheLineSize = 64;
+
+        struct alignas(k_cacheLineSize) Cursor
+        {
+            std::atomic<uint32_t> index = 0;
+            uint32_t cachedOther = 0;
+        };
+
+        // One spare slot distinguishes full from empty without a shared size counter
+        std::unique_ptr<T[]> m_buffer;
+        const uint32_t m_slots;
+        Cursor m_producer;
+        Cursor m_consumer;
+        [[no_unique_address]] StatsPolicy m_stats;
+    };
+
+} // namespace SHAMS
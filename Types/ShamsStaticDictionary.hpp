@@ -0,0 +1,166 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+#include "ShamsHashing.hpp"
+#include "ShamsRobinHoodTable.hpp"
+
+namespace SHAMS
+{
+    /**
+     * @brief Fixed-capacity hash map stored entirely inside the object
+     *
+     * The heap-free counterpart of Dictionary, built on the same RobinHoodTable placement and
+     * control-byte probing. Every slot is an entry holding the key and its value side by side,
+     * so a successful lookup reads one cache line for both. All storage is std::array, so the
+     * dictionary can live on the stack, in static storage or inside other static containers,
+     * and it is copyable like them.
+     *
+     * @note Not thread-safe, like StaticBuffer.
+     *
+     * @tparam key_type - The key type, must be default constructible and equality comparable
+     * @tparam value_type - The value type, must be default constructible
+     * @tparam t_capacity - The maximum number of entries
+     * @tparam Hash - The hash function for key_type
+     * @tparam Equal - The key comparison, must agree with Hash
+     */
+    template <typename key_type, typename value_type, uint32_t t_capacity, typename Hash = KeyHash<key_type>, typename Equal = KeyEqual<key_type>>
+    class StaticDictionary : private RobinHoodTable<StaticDictionary<key_type, value_type, t_capacity, Hash, Equal>, key_type, value_type, Hash, Equal>
+    {
+        using RobinHood = RobinHoodTable<StaticDictionary, key_type, value_type, Hash, Equal>;
+        friend RobinHood;
+        using RobinHood::k_emptyControl;
+        using RobinHood::k_mirroredControls;
+
+    public:
+        StaticDictionary()
+        {
+            m_controls.fill(k_emptyControl);
+        }
+
+        /**
+         * @brief Inserts a key and value
+         *
+         * @param key - The key to insert
+         * @param value - The value to store
+         * @return bool - True if inserted, false if the key already exists or the dictionary is full
+         */
+        bool insert(const key_type &key, const value_type &value)
+        {
+            return this->emplaceItem(key, value).second;
+        }
+
+        bool remove(const key_type &key)
+        {
+            return this->removeItem(key);
+        }
+
+        template <typename Lookup>
+        bool remove(const Lookup &key)
+            requires TransparentKeyFunctions<Hash, Equal>
+        {
+            return this->removeItem(key);
+        }
+
+        bool contains(const key_type &key) const
+        {
+            return this->findIndex(key) != k_slotCount;
+        }
+
+        template <typename Lookup>
+        bool contains(const Lookup &key) const
+            requires TransparentKeyFunctions<Hash, Equal>
+        {
+            return this->findIndex(key) != k_slotCount;
+        }
+
+        value_type &operator[](const key_type &key)
+        {
+            return this->getValue(key);
+        }
+
+        template <typename Lookup>
+        value_type &operator[](const Lookup &key)
+            requires TransparentKeyFunctions<Hash, Equal>
+        {
+            return this->getValue(key);
+        }
+
+        uint32_t size() const
+        {
+            return this->m_size;
+        }
+
+        uint32_t capacity() const
+        {
+            return t_capacity;
+        }
+
+    private:
+        // An eighth more slots than entries, as in Dictionary
+        static constexpr uint32_t k_slotCount = t_capacity + t_capacity / 8 + 1;
+
+        // A distance never exceeds the slot count, so small tables get narrow distances
+        using Distance = std::conditional_t<(k_slotCount < UINT8_MAX), uint8_t,
+                                            std::conditional_t<(k_slotCount < UINT16_MAX), uint16_t, uint32_t>>;
+
+        struct Entry
+        {
+            key_type key;
+            value_type value;
+        };
+
+        // The storage RobinHoodTable works on
+        static constexpr uint32_t slotCount()
+        {
+            return k_slotCount;
+        }
+
+        static constexpr uint32_t maxCapacity()
+        {
+            return t_capacity;
+        }
+
+        uint8_t *controls()
+        {
+            return m_controls.data();
+        }
+
+        const uint8_t *controls() const
+        {
+            return m_controls.data();
+        }
+
+        Distance *distances()
+        {
+            return m_distances.data();
+        }
+
+        key_type &keyAt(uint32_t index)
+        {
+            return m_entries[index].key;
+        }
+
+        const key_type &keyAt(uint32_t index) const
+        {
+            return m_entries[index].key;
+        }
+
+        value_type &valueAt(uint32_t index)
+        {
+            return m_entries[index].value;
+        }
+
+        void markOccupied(uint32_t, bool)
+        {
+        }
+
+    private:
+        std::array<Entry, k_slotCount> m_entries{};
+        std::array<Distance, k_slotCount> m_distances{};
+        std::array<uint8_t, k_slotCount + k_mirroredControls> m_controls;
+    };
+
+} // namespace SHAMS
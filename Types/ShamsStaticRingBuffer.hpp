@@ -2,61 +2,213 @@
 
 #include <cstdint>
 #include <array>
+#include <bit>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <stdexcept>
+#include <type_traits>
+
+#include "ShamsLockPolicy.hpp"
+#include "ShamsQueueStats.hpp"
 
 namespace SHAMS
 {
-    template <typename T, uint32_t capacity>
+    /**
+     * @tparam T - The item type
+     * @tparam t_capacity - The number of items the buffer can hold
+     * @tparam LockPolicy - std::mutex, SpinLock for short critical sections, or NullLock for a buffer used by one thread only
+     * @tparam StatsPolicy - QueueStatsCounters to collect traffic counters for stats(), NoQueueStats to compile them out
+     */
+    template <typename T, uint32_t t_capacity, typename LockPolicy = std::mutex, typename StatsPolicy = NoQueueStats>
     class RingBuffer
     {
 
     public:
         RingBuffer() = default;
 
+        ~RingBuffer()
+        {
+            if constexpr (!std::is_trivially_destructible_v<T>)
+            {
+                for (uint32_t counter = m_head; counter != m_tail; counter = advance(counter))
+                {
+                    std::destroy_at(&m_buffer[slot(counter)].item);
+                }
+            }
+        }
+
         bool push(const T &item)
         {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            if (m_size == capacity)
+            return emplace(item);
+        }
+
+        bool push(T &&item)
+        {
+            return emplace(std::move(item));
+        }
+
+        /**
+         * @brief Constructs an item in place at the tail of the buffer
+         *
+         * @param args - The arguments forwarded to the constructor of T
+         * @return bool - True if the item was pushed, false if the buffer is full
+         */
+        template <typename... Args>
+        bool emplace(Args &&...args)
+        {
+            std::unique_lock<LockPolicy> lock = acquire();
+            if (count() == t_capacity)
             {
+                m_stats.recordRejectedPush();
                 return false;
             }
-            m_buffer[m_tail] = item;
-            m_tail = (m_tail + 1) % capacity;
-            m_size++;
+            std::construct_at(&m_buffer[slot(m_tail)].item, std::forward<Args>(args)...);
+            m_tail = advance(m_tail);
+            m_stats.recordPush(1, count());
             return true;
         }
 
+        /**
+         * @brief Moves the item at the head of the buffer out and destroys its slot
+         *
+         * @param item - Receives the popped item
+         * @return bool - True if an item was popped, false if the buffer is empty
+         */
         bool pop(T &item)
         {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            if (m_size == 0)
+            std::unique_lock<LockPolicy> lock = acquire();
+            if (count() == 0)
             {
+                m_stats.recordFailedPop();
                 return false;
             }
-            item = m_buffer[m_head];
-            m_head = (m_head + 1) % capacity;
-            m_size--;
+            T *head = &m_buffer[slot(m_head)].item;
+            item = std::move(*head);
+            std::destroy_at(head);
+            m_head = advance(m_head);
+            m_stats.recordPop(1);
             return true;
         }
 
+        /**
+         * @brief Moves the item at the head of the buffer out and destroys its slot
+         *
+         * @return std::optional<T> - The popped item, empty if the buffer is empty
+         */
+        std::optional<T> pop()
+        {
+            std::unique_lock<LockPolicy> lock = acquire();
+            if (count() == 0)
+            {
+                m_stats.recordFailedPop();
+                return std::nullopt;
+            }
+            T *head = &m_buffer[slot(m_head)].item;
+            std::optional<T> item(std::move(*head));
+            std::destroy_at(head);
+            m_head = advance(m_head);
+            m_stats.recordPop(1);
+            return item;
+        }
+
         uint32_t size()
         {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            return m_size;
+            std::unique_lock<LockPolicy> lock = acquire();
+            return count();
         }
 
         uint32_t capacity() const
         {
-            return capacity;
+            return t_capacity;
         }
 
+        /**
+         * @brief Returns a snapshot of the traffic counters, all zero unless StatsPolicy is QueueStatsCounters
+         *
+         * @return QueueStats - The counters since construction
+         */
+        QueueStats stats() const
+        {
+            return m_stats.snapshot();
+        }
+
+    private:
+        static constexpr bool k_powerOfTwo = std::has_single_bit(t_capacity);
+
+        // Head and tail are counters rather than slot indices, so full and empty are told apart
+        // without a separate size field. A power-of-two capacity is picked up at compile time:
+        // the counters run freely and are masked, otherwise they wrap at twice the capacity.
+        static constexpr uint32_t advance(uint32_t counter)
+        {
+            if constexpr (k_powerOfTwo)
+            {
+                return counter + 1;
+            }
+            else
+            {
+                return (counter + 1 == 2 * t_capacity) ? 0 : counter + 1;
+            }
+        }
+
+        static constexpr uint32_t slot(uint32_t counter)
+        {
+            if constexpr (k_powerOfTwo)
+            {
+                return counter & (t_capacity - 1);
+            }
+            else
+            {
+                return (counter >= t_capacity) ? counter - t_capacity : counter;
+            }
+        }
+
+        // With stats enabled a failed try_lock is counted as contention before blocking
+        std::unique_lock<LockPolicy> acquire()
+        {
+            if constexpr (StatsPolicy::enabled)
+            {
+                std::unique_lock<LockPolicy> lock(m_lock, std::try_to_lock);
+                if (!lock.owns_lock())
+                {
+                    m_stats.recordContention();
+                    lock.lock();
+                }
+                return lock;
+            }
+            else
+            {
+                return std::unique_lock<LockPolicy>(m_lock);
+            }
+        }
+
+        uint32_t count() const
+        {
+            if constexpr (k_powerOfTwo)
+            {
+                return m_tail - m_head;
+            }
+            else
+            {
+                return (m_tail >= m_head) ? m_tail - m_head : m_tail + 2 * t_capacity - m_head;
+            }
+        }
+
+        // Raw storage for one item, constructed on push and destroyed on pop
+        union Slot
+        {
+            Slot() {}
+            ~Slot() {}
+
+            T item;
+        };
+
     private:
-        std::array<T, capacity> m_buffer;
-        std::mutex m_mutex;
+        std::array<Slot, t_capacity> m_buffer;
+        LockPolicy m_lock;
         uint32_t m_head = 0;
         uint32_t m_tail = 0;
-        uint32_t m_size = 0;
+        [[no_unique_address]] StatsPolicy m_stats;
     };
 
 } // namespace SHAMS
@@ -0,0 +1,158 @@
+#include "ShamsRingBuffer.hpp"
+#include "ShamsSpscRingBuffer.hpp"
+#include "ShamsMpmcRingBuffer.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr uint32_t k_itemCount = 1'000'000;
+    constexpr uint32_t k_capacity = 1024;
+
+    /**
+     * @brief Streams k_itemCount items from one producer thread to one consumer thread
+     *
+     * @return double - Throughput in millions of items per second
+     */
+    template <typename Queue>
+    double oneToOneThroughput(Queue &queue)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        std::thread producer([&queue]()
+                             {
+            for (uint32_t i = 0; i < k_itemCount; i++)
+            {
+                while (!queue.push(i))
+                {
+                    std::this_thread::yield();
+                }
+            } });
+
+        uint32_t item = 0;
+        for (uint32_t received = 0; received < k_itemCount;)
+        {
+            if (queue.pop(item))
+            {
+                received++;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return k_itemCount / elapsed.count() / 1e6;
+    }
+
+    /**
+     * @brief Streams k_itemCount items through the queue split across several producer and consumer threads
+     *
+     * @param pairs - The number of producer threads, and of consumer threads
+     * @return double - Throughput in millions of items per second
+     */
+    template <typename Queue>
+    double manyToManyThroughput(Queue &queue, uint32_t pairs)
+    {
+        const uint32_t itemsPerProducer = k_itemCount / pairs;
+        std::atomic<uint32_t> received = 0;
+        std::vector<std::thread> threads;
+        const auto start = std::chrono::steady_clock::now();
+
+        for (uint32_t p = 0; p < pairs; p++)
+        {
+            threads.emplace_back([&queue, itemsPerProducer]()
+                                 {
+                for (uint32_t i = 0; i < itemsPerProducer; i++)
+                {
+                    while (!queue.push(i))
+                    {
+                        std::this_thread::yield();
+                    }
+                } });
+            threads.emplace_back([&queue, &received, pairs, itemsPerProducer]()
+                                 {
+                uint32_t item = 0;
+                while (received.load(std::memory_order_relaxed) < pairs * itemsPerProducer)
+                {
+                    if (queue.pop(item))
+                    {
+                        received.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                    }
+                } });
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return pairs * itemsPerProducer / elapsed.count() / 1e6;
+    }
+
+    /**
+     * @brief Moves k_itemCount items through the queue on one thread, either one at a time or in blocks
+     *
+     * @return double - Throughput in millions of items per second
+     */
+    template <uint32_t t_blockSize>
+    double blockThroughput(SHAMS::RingBuffer<uint32_t> &queue)
+    {
+        std::array<uint32_t, t_blockSize> block{};
+        const auto start = std::chrono::steady_clock::now();
+
+        for (uint32_t i = 0; i < k_itemCount; i += t_blockSize)
+        {
+            if constexpr (t_blockSize == 1)
+            {
+                queue.push(block[0]);
+                queue.pop(block[0]);
+            }
+            else
+            {
+                queue.pushN(block);
+                queue.popN(block);
+            }
+        }
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return k_itemCount / elapsed.count() / 1e6;
+    }
+} // namespace
+
+int main()
+{
+    {
+        SHAMS::RingBuffer<uint32_t> queue(k_capacity);
+        std::printf("RingBuffer (mutex)      1P/1C: %8.2f Mitems/s\n", oneToOneThroughput(queue));
+    }
+    {
+        SHAMS::SpscRingBuffer<uint32_t> queue(k_capacity);
+        std::printf("SpscRingBuffer          1P/1C: %8.2f Mitems/s\n", oneToOneThroughput(queue));
+    }
+    for (uint32_t pairs : {1u, 2u, 4u})
+    {
+        SHAMS::RingBuffer<uint32_t> mutexQueue(k_capacity);
+        SHAMS::MpmcRingBuffer<uint32_t, k_capacity> mpmcQueue;
+        std::printf("RingBuffer (mutex)      %uP/%uC: %8.2f Mitems/s\n", pairs, pairs, manyToManyThroughput(mutexQueue, pairs));
+        std::printf("MpmcRingBuffer          %uP/%uC: %8.2f Mitems/s\n", pairs, pairs, manyToManyThroughput(mpmcQueue, pairs));
+    }
+    {
+        SHAMS::RingBuffer<uint32_t> queue(k_capacity);
+        std::printf("RingBuffer push/pop     single: %8.2f Mitems/s\n", blockThroughput<1>(queue));
+        std::printf("RingBuffer pushN/popN   x256:   %8.2f Mitems/s\n", blockThroughput<256>(queue));
+    }
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include "gtest/gtest.h"
+#include "ShamsBroadcastRingBuffer.hpp"
+
+#include <thread>
+#include <vector>
+
+TEST(BroadcastRingBufferTests, CanCreateBuffer)
+{
+    SHAMS::BroadcastRingBuffer<int> buffer(6, 3);
+    EXPECT_EQ(buffer.capacity(), 8);
+    EXPECT_EQ(buffer.consumers(), 3);
+    EXPECT_THROW(SHAMS::BroadcastRingBuffer<int>(4, 0), std::invalid_argument);
+}
+
+TEST(BroadcastRingBufferTests, EveryConsumerReadsEveryItem)
+{
+    SHAMS::BroadcastRingBuffer<int> buffer(4, 2);
+    int item = 0;
+
+    EXPECT_TRUE(buffer.push(1));
+    EXPECT_TRUE(buffer.push(2));
+
+    for (uint32_t consumer = 0; consumer < 2; consumer++)
+    {
+        EXPECT_EQ(buffer.size(consumer), 2);
+        ASSERT_TRUE(buffer.pop(consumer, item));
+        EXPECT_EQ(item, 1);
+        ASSERT_TRUE(buffer.pop(consumer, item));
+        EXPECT_EQ(item, 2);
+        EXPECT_FALSE(buffer.pop(consumer, item));
+    }
+    EXPECT_THROW(buffer.pop(2, item), std::out_of_range);
+}
+
+TEST(BroadcastRingBufferTests, ProducerIsHeldBackBySlowestConsumer)
+{
+    SHAMS::BroadcastRingBuffer<int> buffer(2, 2);
+    int item = 0;
+
+    EXPECT_TRUE(buffer.push(1));
+    EXPECT_TRUE(buffer.push(2));
+    EXPECT_FALSE(buffer.push(3));
+
+    // Only the fast consumer catches up, the slow one still pins both slots
+    buffer.pop(0, item);
+    buffer.pop(0, item);
+    EXPECT_FALSE(buffer.push(3));
+
+    buffer.pop(1, item);
+    EXPECT_TRUE(buffer.push(3));
+    EXPECT_FALSE(buffer.push(4));
+}
+
+TEST(BroadcastRingBufferTests, PeekReadsInPlaceUntilRelease)
+{
+    SHAMS::BroadcastRingBuffer<int> buffer(2, 1);
+
+    EXPECT_EQ(buffer.peek(0), nullptr);
+    buffer.push(5);
+
+    const int *item = buffer.peek(0);
+    ASSERT_NE(item, nullptr);
+    EXPECT_EQ(*item, 5);
+    EXPECT_EQ(buffer.peek(0), item);
+
+    buffer.release(0);
+    EXPECT_EQ(buffer.peek(0), nullptr);
+}
+
+TEST(BroadcastRingBufferTests, ReleaseWithoutItemThrows)
+{
+    SHAMS::BroadcastRingBuffer<int> buffer(2, 2);
+
+    EXPECT_THROW(buffer.release(0), std::out_of_range);
+    EXPECT_EQ(buffer.size(0), 0);
+
+    buffer.push(1);
+    ASSERT_NE(buffer.peek(0), nullptr);
+    buffer.release(0);
+    EXPECT_THROW(buffer.release(0), std::out_of_range);
+    EXPECT_EQ(buffer.size(0), 0);
+    EXPECT_EQ(buffer.size(1), 1);
+}
+
+TEST(BroadcastRingBufferTests, StatsCountEveryConsumersReads)
+{
+    SHAMS::BroadcastRingBuffer<int, SHAMS::QueueStatsCounters> buffer(2, 2);
+    int item = 0;
+
+    buffer.push(1);
+    buffer.push(2);
+    EXPECT_FALSE(buffer.push(3));
+    for (uint32_t consumer = 0; consumer < 2; consumer++)
+    {
+        buffer.pop(consumer, item);
+        buffer.pop(consumer, item);
+    }
+    EXPECT_FALSE(buffer.pop(0, item));
+
+    const SHAMS::QueueStats stats = buffer.stats();
+    EXPECT_EQ(stats.pushes, 2);
+    EXPECT_EQ(stats.pops, 4);
+    EXPECT_EQ(stats.rejectedPushes, 1);
+    EXPECT_EQ(stats.failedPops, 1);
+    EXPECT_EQ(stats.peakSize, 2);
+}
+
+TEST(BroadcastRingBufferTests, ConsumerThreadsEachSeeTheFullStream)
+{
+    constexpr int itemCount = 50000;
+    constexpr uint32_t consumerCount = 3;
+    SHAMS::BroadcastRingBuffer<int> buffer(64, consumerCount);
+    std::vector<long long> sums(consumerCount, 0);
+    std::vector<std::thread> consumers;
+
+    for (uint32_t consumer = 0; consumer < consumerCount; consumer++)
+    {
+        consumers.emplace_back([&buffer, &sums, consumer]()
+                               {
+            int item = 0;
+            for (int received = 0; received < itemCount;)
+            {
+                if (buffer.pop(consumer, item))
+                {
+                    sums[consumer] += item;
+                    received++;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            } });
+    }
+    for (int i = 1; i <= itemCount; i++)
+    {
+        while (!buffer.push(i))
+        {
+            std::this_thread::yield();
+        }
+    }
+    for (auto &consumer : consumers)
+    {
+        consumer.join();
+    }
+
+    for (uint32_t consumer = 0; consumer < consumerCount; consumer++)
+    {
+        EXPECT_EQ(sums[consumer], static_cast<long long>(itemCount) * (itemCount + 1) / 2);
+    }
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <ShamsConcurrentDictionary.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(ConcurrentDictionary, InsertRetrieveRemove)
+{
+    SHAMS::ConcurrentDictionary<std::string, int> dict(8);
+
+    ASSERT_TRUE(dict.insert("one", 1));
+    ASSERT_TRUE(dict.insert("two", 2));
+    ASSERT_FALSE(dict.insert("one", 3));
+
+    ASSERT_EQ(dict["one"], 1);
+    ASSERT_TRUE(dict.contains("two"));
+    ASSERT_TRUE(dict.remove("two"));
+    ASSERT_FALSE(dict.contains("two"));
+    ASSERT_EQ(dict.size(), 1);
+    ASSERT_THROW(dict["two"], std::out_of_range);
+}
+
+TEST(ConcurrentDictionary, ShardFillsIndependently)
+{
+    SHAMS::ConcurrentDictionary<int, int, 1> dict(2);
+
+    ASSERT_TRUE(dict.insert(1, 1));
+    ASSERT_TRUE(dict.insert(2, 2));
+    ASSERT_FALSE(dict.insert(3, 3));
+    ASSERT_EQ(dict.shards(), 1);
+}
+
+TEST(ConcurrentDictionary, StridedKeysUseEveryShard)
+{
+    // Keys sharing their low bits, like IDs at a fixed stride or aligned pointers
+    constexpr uint64_t k_stride = 2048;
+    SHAMS::ConcurrentDictionary<uint64_t, int, 16> dict(100);
+
+    for (uint64_t i = 0; i < 1000; i++)
+    {
+        ASSERT_TRUE(dict.insert(i * k_stride, 0));
+    }
+    for (uint64_t i = 1000; i < 20000; i++)
+    {
+        dict.insert(i * k_stride, 0);
+    }
+    ASSERT_EQ(dict.size(), 16 * 100);
+}
+
+TEST(ConcurrentDictionary, ConcurrentWritersAndReaders)
+{
+    constexpr int k_threads = 4;
+    constexpr int k_keysPerThread = 2000;
+    SHAMS::ConcurrentDictionary<int, int, 16> dict(k_threads * k_keysPerThread / 8);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < k_threads; t++)
+    {
+        threads.emplace_back([&dict, t]()
+                             {
+            for (int i = 0; i < k_keysPerThread; i++)
+            {
+                const int key = t * k_keysPerThread + i;
+                dict.insert(key, key * 2);
+                dict.contains(key + 1);
+            }
+            for (int i = 0; i < k_keysPerThread; i += 2)
+            {
+                dict.remove(t * k_keysPerThread + i);
+            } });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(dict.size(), k_threads * k_keysPerThread / 2);
+    for (int key = 0; key < k_threads * k_keysPerThread; key++)
+    {
+        ASSERT_EQ(dict.contains(key), key % 2 == 1);
+        if (key % 2 == 1)
+        {
+            ASSERT_EQ(dict[key], key * 2);
+        }
+    }
+}
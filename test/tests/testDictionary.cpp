@@ -1,5 +1,12 @@
 #include <gtest/gtest.h>
 #include <ShamsDictionary.hpp>
+#include <ShamsStaticString.hpp>
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 TEST(Dictionary, Insert)
 {
@@ -74,4 +81,276 @@ TEST(Dictionary, InsertWithMaxCapacity)
     dict.insert(2, 20);
     ASSERT_FALSE(dict.insert(3, 30));
     ASSERT_EQ(dict.size(), 2);
-}
\ No newline at end of file
+}
+
+TEST(Dictionary, NullLockPolicy)
+{
+    SHAMS::Dictionary<int, int, SHAMS::NullLock> dict(4);
+
+    dict.insert(1, 10);
+    dict.insert(2, 20);
+
+    ASSERT_TRUE(dict.contains(2));
+    ASSERT_EQ(dict[1], 10);
+    ASSERT_EQ(dict.size(), 2);
+}
+
+TEST(Dictionary, SpinLockPolicy)
+{
+    SHAMS::Dictionary<int, int, SHAMS::SpinLock> dict(4);
+
+    dict.insert(1, 10);
+    dict.remove(1);
+
+    ASSERT_FALSE(dict.contains(1));
+    ASSERT_EQ(dict.size(), 0);
+}
+
+TEST(Dictionary, MissingKeyThrows)
+{
+    SHAMS::Dictionary<int, int> dict(4);
+
+    dict.insert(1, 10);
+    dict.remove(1);
+
+    ASSERT_THROW(dict[1], std::out_of_range);
+}
+
+struct CollidingHash
+{
+    size_t operator()(int key) const
+    {
+        return static_cast<size_t>(key % 2);
+    }
+};
+
+TEST(Dictionary, RemoveKeepsCollidingKeysReachable)
+{
+    SHAMS::Dictionary<int, int, std::mutex, CollidingHash> dict(8);
+
+    for (int key = 0; key < 8; key++)
+    {
+        ASSERT_TRUE(dict.insert(key, key * 10));
+    }
+    ASSERT_FALSE(dict.insert(8, 80));
+
+    ASSERT_TRUE(dict.remove(0));
+    ASSERT_TRUE(dict.remove(3));
+    for (int key = 0; key < 8; key++)
+    {
+        ASSERT_EQ(dict.contains(key), key != 0 and key != 3);
+    }
+    ASSERT_EQ(dict[7], 70);
+    ASSERT_TRUE(dict.insert(8, 80));
+    ASSERT_EQ(dict[8], 80);
+}
+
+TEST(Dictionary, MatchesReferenceMapUnderRandomOperations)
+{
+    constexpr uint32_t k_capacity = 1000;
+    SHAMS::Dictionary<uint32_t, uint32_t> dict(k_capacity);
+    std::unordered_map<uint32_t, uint32_t> reference;
+    std::mt19937 random(42);
+
+    for (int i = 0; i < 100000; i++)
+    {
+        const uint32_t key = random() % 2000;
+        if (random() % 2 == 0)
+        {
+            const bool expected = reference.size() < k_capacity and !reference.contains(key);
+            ASSERT_EQ(dict.insert(key, i), expected);
+            if (expected)
+            {
+                reference[key] = i;
+            }
+        }
+        else
+        {
+            ASSERT_EQ(dict.remove(key), reference.erase(key) == 1);
+        }
+    }
+    ASSERT_EQ(dict.size(), reference.size());
+    for (const auto &[key, value] : reference)
+    {
+        ASSERT_EQ(dict[key], value);
+    }
+}
+
+TEST(Dictionary, LongClustersSpanSeveralControlGroups)
+{
+    SHAMS::Dictionary<int, int, std::mutex, CollidingHash> dict(40);
+
+    for (int key = 0; key < 40; key++)
+    {
+        ASSERT_TRUE(dict.insert(key, key));
+    }
+    for (int key = 0; key < 40; key += 3)
+    {
+        ASSERT_TRUE(dict.remove(key));
+    }
+    for (int key = 0; key < 40; key++)
+    {
+        ASSERT_EQ(dict.contains(key), key % 3 != 0);
+    }
+    ASSERT_FALSE(dict.contains(40));
+}
+
+TEST(Dictionary, LargeStringKeyedTable)
+{
+    constexpr int k_entries = 10000;
+    SHAMS::Dictionary<std::string, int> dict(k_entries);
+
+    for (int i = 0; i < k_entries; i++)
+    {
+        ASSERT_TRUE(dict.insert("key-" + std::to_string(i), i));
+    }
+    ASSERT_FALSE(dict.insert("one-too-many", 0));
+    for (int i = 0; i < k_entries; i++)
+    {
+        ASSERT_EQ(dict["key-" + std::to_string(i)], i);
+        ASSERT_FALSE(dict.contains("missing-" + std::to_string(i)));
+    }
+}
+
+TEST(Dictionary, CopyConstructorCopiesEntries)
+{
+    SHAMS::Dictionary<std::string, int> original(4);
+    original.insert("one", 1);
+    original.insert("two", 2);
+
+    SHAMS::Dictionary<std::string, int> copy(original);
+    original.remove("one");
+
+    ASSERT_EQ(copy.size(), 2);
+    ASSERT_EQ(copy["one"], 1);
+    ASSERT_EQ(copy["two"], 2);
+}
+
+TEST(Dictionary, TransparentLookupWithStringKeys)
+{
+    SHAMS::Dictionary<std::string, int> dict(4);
+    dict.insert("a key longer than the small string buffer", 1);
+    dict.insert("two", 2);
+
+    const std::string_view view = "a key longer than the small string buffer";
+    const char *cString = "two";
+    const SHAMS::StaticString<8> staticString("two");
+
+    ASSERT_TRUE(dict.contains(view));
+    ASSERT_EQ(dict[view], 1);
+    ASSERT_TRUE(dict.contains(cString));
+    ASSERT_EQ(dict[staticString], 2);
+    ASSERT_FALSE(dict.contains(std::string_view("three")));
+    ASSERT_TRUE(dict.remove(staticString));
+    ASSERT_FALSE(dict.contains(cString));
+}
+
+TEST(Dictionary, FindManyResolvesABatch)
+{
+    SHAMS::Dictionary<int, int> dict(64);
+    for (int key = 0; key < 40; key++)
+    {
+        dict.insert(key, key * 10);
+    }
+
+    std::vector<int> keys;
+    for (int key = 0; key < 50; key++)
+    {
+        keys.push_back(key);
+    }
+    std::vector<int *> values(keys.size());
+
+    ASSERT_EQ(dict.findMany(keys, values), 40);
+    for (int key = 0; key < 50; key++)
+    {
+        if (key < 40)
+        {
+            ASSERT_NE(values[key], nullptr);
+            ASSERT_EQ(*values[key], key * 10);
+        }
+        else
+        {
+            ASSERT_EQ(values[key], nullptr);
+        }
+    }
+
+    std::vector<int *> tooFew(1);
+    ASSERT_THROW(dict.findMany(keys, tooFew), std::invalid_argument);
+}
+
+TEST(Dictionary, FindReturnsNullForMissingKey)
+{
+    SHAMS::Dictionary<std::string, int> dict(4);
+    dict.insert("one", 1);
+
+    int *value = dict.find("one");
+    ASSERT_NE(value, nullptr);
+    *value = 11;
+
+    ASSERT_EQ(dict["one"], 11);
+    ASSERT_EQ(dict.find("two"), nullptr);
+}
+
+TEST(Dictionary, TryEmplaceKeepsExistingValue)
+{
+    SHAMS::Dictionary<int, std::string> dict(2);
+
+    auto [first, inserted] = dict.tryEmplace(1, 3, 'a');
+    ASSERT_TRUE(inserted);
+    ASSERT_EQ(*first, "aaa");
+
+    auto [existing, insertedAgain] = dict.tryEmplace(1, "ignored");
+    ASSERT_FALSE(insertedAgain);
+    ASSERT_EQ(*existing, "aaa");
+
+    dict.tryEmplace(2, "two");
+    auto [full, insertedWhenFull] = dict.tryEmplace(3, "three");
+    ASSERT_EQ(full, nullptr);
+    ASSERT_FALSE(insertedWhenFull);
+}
+
+TEST(Dictionary, InsertOrAssignUpdatesInPlace)
+{
+    SHAMS::Dictionary<int, int, std::mutex, CollidingHash> dict(4);
+
+    ASSERT_TRUE(dict.insertOrAssign(2, 20).second);
+    ASSERT_TRUE(dict.insertOrAssign(4, 40).second);
+    ASSERT_FALSE(dict.insertOrAssign(4, 44).second);
+
+    ASSERT_EQ(dict[2], 20);
+    ASSERT_EQ(dict[4], 44);
+    ASSERT_EQ(dict.size(), 2);
+}
+
+TEST(Dictionary, ForEachVisitsEveryEntryOnce)
+{
+    SHAMS::Dictionary<int, int> dict(200);
+    for (int key = 0; key < 200; key++)
+    {
+        dict.insert(key, key);
+    }
+    for (int key = 0; key < 200; key += 2)
+    {
+        dict.remove(key);
+    }
+
+    std::unordered_map<int, int> visited;
+    dict.forEach([&visited](const int &key, int &value)
+                 {
+        visited[key]++;
+        value *= 2; });
+
+    ASSERT_EQ(visited.size(), 100);
+    for (const auto &[key, count] : visited)
+    {
+        ASSERT_EQ(key % 2, 1);
+        ASSERT_EQ(count, 1);
+        ASSERT_EQ(dict[key], key * 2);
+    }
+
+    SHAMS::Dictionary<int, int> copy(dict);
+    uint32_t copied = 0;
+    copy.forEach([&copied](const int &, int &)
+                 { copied++; });
+    ASSERT_EQ(copied, 100);
+}
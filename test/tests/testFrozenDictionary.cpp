@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <ShamsFrozenDictionary.hpp>
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace
+{
+    enum class Register
+    {
+        Status,
+        Control,
+        Data
+    };
+
+    constexpr SHAMS::FrozenDictionary<std::string_view, int, 4> k_commands({{"start", 1}, {"stop", 2}, {"reset", 3}, {"status", 4}});
+    constexpr SHAMS::FrozenDictionary<Register, uint16_t, 3> k_addresses({{Register::Status, 0x10}, {Register::Control, 0x14}, {Register::Data, 0x18}});
+
+    static_assert(k_commands.at("reset") == 3);
+    static_assert(!k_commands.contains("pause"));
+    static_assert(k_addresses[Register::Control] == 0x14);
+}
+
+TEST(FrozenDictionary, LooksUpCompileTimeTable)
+{
+    const std::string command = "status";
+
+    ASSERT_EQ(k_commands.size(), 4);
+    ASSERT_EQ(k_commands[command], 4);
+    ASSERT_EQ(k_commands.find("start") != nullptr, true);
+    ASSERT_EQ(k_commands.find("pause"), nullptr);
+    ASSERT_THROW(k_commands.at("pause"), std::out_of_range);
+    ASSERT_EQ(k_addresses.at(Register::Data), 0x18);
+}
+
+constexpr std::array<std::pair<uint32_t, uint32_t>, 256> makeEntries()
+{
+    std::array<std::pair<uint32_t, uint32_t>, 256> entries{};
+    for (uint32_t i = 0; i < entries.size(); i++)
+    {
+        entries[i] = {i * 7919, i};
+    }
+    return entries;
+}
+
+TEST(FrozenDictionary, EveryKeyGetsItsOwnSlot)
+{
+    constexpr auto entries = makeEntries();
+    std::pair<uint32_t, uint32_t> raw[entries.size()];
+    std::copy(entries.begin(), entries.end(), raw);
+    const SHAMS::FrozenDictionary<uint32_t, uint32_t, 256> dict(raw);
+
+    for (const auto &[key, value] : entries)
+    {
+        ASSERT_EQ(dict.at(key), value);
+    }
+    ASSERT_FALSE(dict.contains(1));
+}
+
+TEST(FrozenDictionary, DuplicateKeysAreRejected)
+{
+    ASSERT_THROW((SHAMS::FrozenDictionary<int, int, 3>({{1, 1}, {2, 2}, {1, 3}})), std::invalid_argument);
+}
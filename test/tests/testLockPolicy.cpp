@@ -0,0 +1,51 @@
+#include "gtest/gtest.h"
+#include "ShamsLockPolicy.hpp"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+TEST(LockPolicyTests, SpinLockTryLockFailsWhileHeld)
+{
+    SHAMS::SpinLock lock;
+
+    ASSERT_TRUE(lock.try_lock());
+    EXPECT_FALSE(lock.try_lock());
+    lock.unlock();
+    EXPECT_TRUE(lock.try_lock());
+    lock.unlock();
+}
+
+TEST(LockPolicyTests, SpinLockExcludesOtherThreads)
+{
+    constexpr int k_threads = 4;
+    constexpr int k_increments = 10000;
+    SHAMS::SpinLock lock;
+    int counter = 0;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < k_threads; t++)
+    {
+        threads.emplace_back([&lock, &counter]()
+                             {
+            for (int i = 0; i < k_increments; i++)
+            {
+                std::lock_guard<SHAMS::SpinLock> guard(lock);
+                counter++;
+            } });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(counter, k_threads * k_increments);
+}
+
+TEST(LockPolicyTests, NullLockAlwaysSucceeds)
+{
+    SHAMS::NullLock lock;
+
+    EXPECT_TRUE(lock.try_lock());
+    EXPECT_TRUE(lock.try_lock());
+    lock.unlock();
+}
@@ -0,0 +1,106 @@
+#include "gtest/gtest.h"
+#include "ShamsMpmcRingBuffer.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST(MpmcRingBufferTests, CanCreateBuffer)
+{
+    SHAMS::MpmcRingBuffer<int, 16> buffer;
+    EXPECT_EQ(buffer.capacity(), 16);
+    EXPECT_EQ(buffer.size(), 0);
+}
+
+TEST(MpmcRingBufferTests, PushFailsWhenFull)
+{
+    SHAMS::MpmcRingBuffer<int, 4> buffer;
+
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT_TRUE(buffer.push(i));
+    }
+    EXPECT_FALSE(buffer.push(4));
+    EXPECT_EQ(buffer.size(), 4);
+}
+
+TEST(MpmcRingBufferTests, PopReturnsItemsInOrderAcrossWrap)
+{
+    SHAMS::MpmcRingBuffer<int, 4> buffer;
+    int item = 0;
+
+    for (int i = 0; i < 10; i++)
+    {
+        ASSERT_TRUE(buffer.push(i));
+        ASSERT_TRUE(buffer.pop(item));
+        ASSERT_EQ(item, i);
+    }
+    EXPECT_FALSE(buffer.pop(item));
+}
+
+TEST(MpmcRingBufferTests, StatsCountTrafficAndPeak)
+{
+    SHAMS::MpmcRingBuffer<int, 2, SHAMS::QueueStatsCounters> buffer;
+    int item = 0;
+
+    buffer.push(1);
+    buffer.push(2);
+    EXPECT_FALSE(buffer.push(3));
+    buffer.pop(item);
+    buffer.pop(item);
+    EXPECT_FALSE(buffer.pop(item));
+
+    const SHAMS::QueueStats stats = buffer.stats();
+    EXPECT_EQ(stats.pushes, 2);
+    EXPECT_EQ(stats.pops, 2);
+    EXPECT_EQ(stats.rejectedPushes, 1);
+    EXPECT_EQ(stats.failedPops, 1);
+    EXPECT_EQ(stats.peakSize, 2);
+}
+
+TEST(MpmcRingBufferTests, MultipleProducersAndConsumers)
+{
+    constexpr int threadCount = 4;
+    constexpr int itemsPerProducer = 20000;
+    SHAMS::MpmcRingBuffer<int, 64> buffer;
+    std::atomic<long long> sum = 0;
+    std::atomic<int> received = 0;
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < threadCount; t++)
+    {
+        threads.emplace_back([&buffer]()
+                             {
+            for (int i = 1; i <= itemsPerProducer; i++)
+            {
+                while (!buffer.push(i))
+                {
+                    std::this_thread::yield();
+                }
+            } });
+        threads.emplace_back([&buffer, &sum, &received]()
+                             {
+            int item = 0;
+            while (received.load() < threadCount * itemsPerProducer)
+            {
+                if (buffer.pop(item))
+                {
+                    sum += item;
+                    received++;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            } });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    const long long expected = threadCount * (static_cast<long long>(itemsPerProducer) * (itemsPerProducer + 1) / 2);
+    EXPECT_EQ(received.load(), threadCount * itemsPerProducer);
+    EXPECT_EQ(sum.load(), expected);
+    EXPECT_EQ(buffer.size(), 0);
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <ShamsReadMostlyDictionary.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(ReadMostlyDictionary, InsertRetrieveRemove)
+{
+    SHAMS::ReadMostlyDictionary<std::string, int> dict(4);
+
+    ASSERT_TRUE(dict.insert("one", 1));
+    ASSERT_FALSE(dict.insert("one", 2));
+    ASSERT_TRUE(dict.insert("two", 2));
+
+    ASSERT_EQ(dict["one"], 1);
+    ASSERT_TRUE(dict.remove("one"));
+    ASSERT_FALSE(dict.remove("one"));
+    ASSERT_FALSE(dict.contains("one"));
+    ASSERT_THROW(dict["one"], std::out_of_range);
+    ASSERT_EQ(dict.size(), 1);
+}
+
+TEST(ReadMostlyDictionary, ReadersSeeConsistentSnapshotsDuringWrites)
+{
+    constexpr int k_readers = 3;
+    constexpr int k_writes = 200;
+    SHAMS::ReadMostlyDictionary<int, int> dict(k_writes + 1);
+    std::atomic<bool> done = false;
+    std::atomic<int> errors = 0;
+
+    ASSERT_TRUE(dict.insert(0, 0));
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < k_readers; r++)
+    {
+        readers.emplace_back([&dict, &done, &errors]()
+                             {
+            while (!done.load())
+            {
+                // Keys are only ever added, in order, and each maps to its own double
+                if (dict[0] != 0)
+                {
+                    errors++;
+                }
+                const int newest = static_cast<int>(dict.size()) - 1;
+                if (!dict.contains(newest) or dict[newest] != newest * 2)
+                {
+                    errors++;
+                }
+                std::this_thread::yield();
+            } });
+    }
+
+    for (int key = 1; key <= k_writes; key++)
+    {
+        ASSERT_TRUE(dict.insert(key, key * 2));
+    }
+    done = true;
+    for (std::thread &reader : readers)
+    {
+        reader.join();
+    }
+
+    ASSERT_EQ(errors.load(), 0);
+    ASSERT_EQ(dict.size(), k_writes + 1);
+    ASSERT_EQ(dict[k_writes], k_writes * 2);
+}
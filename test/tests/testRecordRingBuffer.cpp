@@ -0,0 +1,128 @@
+#include "gtest/gtest.h"
+#include "ShamsRecordRingBuffer.hpp"
+
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace
+{
+    std::span<const std::byte> bytesOf(std::string_view text)
+    {
+        return std::as_bytes(std::span(text.data(), text.size()));
+    }
+
+    std::string textOf(std::span<const std::byte> bytes)
+    {
+        return std::string(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+    }
+} // namespace
+
+TEST(RecordRingBufferTests, CanCreateBuffer)
+{
+    SHAMS::RecordRingBuffer buffer(100);
+    EXPECT_EQ(buffer.capacity(), 128);
+    EXPECT_EQ(buffer.maxRecordLength(), 60);
+    EXPECT_EQ(buffer.usedBytes(), 0);
+}
+
+TEST(RecordRingBufferTests, RecordsKeepTheirLengths)
+{
+    SHAMS::RecordRingBuffer buffer(64);
+
+    ASSERT_TRUE(buffer.tryWrite(bytesOf("a")));
+    ASSERT_TRUE(buffer.tryWrite(bytesOf("")));
+    ASSERT_TRUE(buffer.tryWrite(bytesOf("hello world")));
+    EXPECT_EQ(buffer.usedBytes(), 8 + 4 + 16);
+
+    auto record = buffer.tryRead();
+    ASSERT_TRUE(record.has_value());
+    EXPECT_EQ(textOf(*record), "a");
+    buffer.release();
+
+    record = buffer.tryRead();
+    ASSERT_TRUE(record.has_value());
+    EXPECT_TRUE(record->empty());
+    buffer.release();
+
+    record = buffer.tryRead();
+    ASSERT_TRUE(record.has_value());
+    EXPECT_EQ(textOf(*record), "hello world");
+    buffer.release();
+
+    EXPECT_FALSE(buffer.tryRead().has_value());
+    EXPECT_EQ(buffer.usedBytes(), 0);
+}
+
+TEST(RecordRingBufferTests, WriteFailsWhenFullOrTooLarge)
+{
+    SHAMS::RecordRingBuffer buffer(32);
+
+    EXPECT_FALSE(buffer.tryWrite(bytesOf("this record is too long")));
+    EXPECT_TRUE(buffer.tryWrite(bytesOf("0123456789")));
+    EXPECT_TRUE(buffer.tryWrite(bytesOf("0123456789")));
+    EXPECT_FALSE(buffer.tryWrite(bytesOf("x")));
+}
+
+TEST(RecordRingBufferTests, ReleaseWithoutReadThrows)
+{
+    SHAMS::RecordRingBuffer buffer(32);
+
+    EXPECT_THROW(buffer.release(), std::out_of_range);
+    EXPECT_EQ(buffer.usedBytes(), 0);
+
+    ASSERT_TRUE(buffer.tryWrite(bytesOf("abc")));
+    ASSERT_TRUE(buffer.tryRead().has_value());
+    buffer.release();
+    EXPECT_THROW(buffer.release(), std::out_of_range);
+    EXPECT_EQ(buffer.usedBytes(), 0);
+    EXPECT_FALSE(buffer.tryRead().has_value());
+}
+
+TEST(RecordRingBufferTests, RecordsAreNeverSplitAcrossTheWrap)
+{
+    SHAMS::RecordRingBuffer buffer(32);
+
+    ASSERT_TRUE(buffer.tryWrite(bytesOf("0123456789")));
+    ASSERT_TRUE(buffer.tryRead().has_value());
+    buffer.release();
+
+    // 16 bytes are used from the front, a 12-byte record would wrap so it goes to the start
+    ASSERT_TRUE(buffer.tryWrite(bytesOf("abcdefghijkl")));
+    auto record = buffer.tryRead();
+    ASSERT_TRUE(record.has_value());
+    EXPECT_EQ(textOf(*record), "abcdefghijkl");
+    buffer.release();
+    EXPECT_EQ(buffer.usedBytes(), 0);
+}
+
+TEST(RecordRingBufferTests, WriterAndReaderThreads)
+{
+    constexpr int recordCount = 20000;
+    SHAMS::RecordRingBuffer buffer(256);
+
+    std::thread writer([&buffer]()
+                       {
+        for (int i = 0; i < recordCount; i++)
+        {
+            const std::string record(static_cast<size_t>(i % 40), static_cast<char>('a' + i % 26));
+            while (!buffer.tryWrite(bytesOf(record)))
+            {
+                std::this_thread::yield();
+            }
+        } });
+
+    for (int i = 0; i < recordCount;)
+    {
+        auto record = buffer.tryRead();
+        if (!record)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        ASSERT_EQ(textOf(*record), std::string(static_cast<size_t>(i % 40), static_cast<char>('a' + i % 26)));
+        buffer.release();
+        i++;
+    }
+    writer.join();
+}
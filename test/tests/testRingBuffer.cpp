@@ -1,8 +1,550 @@
 #include "gtest/gtest.h"
 #include "ShamsRingBuffer.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
 TEST(RingBufferTests, CanCreateBuffer)
 {
     auto buffer = SHAMS::RingBuffer<int>(10);
     EXPECT_EQ(buffer.capacity(), 10);
-}
\ No newline at end of file
+}
+
+TEST(RingBufferTests, PushAndPopSingleItems)
+{
+    SHAMS::RingBuffer<int> buffer(2);
+    int item = 0;
+
+    EXPECT_TRUE(buffer.push(1));
+    EXPECT_TRUE(buffer.push(2));
+    EXPECT_FALSE(buffer.push(3));
+    EXPECT_TRUE(buffer.pop(item));
+    EXPECT_EQ(item, 1);
+    EXPECT_TRUE(buffer.pop(item));
+    EXPECT_EQ(item, 2);
+    EXPECT_FALSE(buffer.pop(item));
+}
+
+TEST(RingBufferTests, PushNStopsWhenFull)
+{
+    SHAMS::RingBuffer<int> buffer(4);
+    const int block[] = {1, 2, 3, 4, 5, 6};
+
+    EXPECT_EQ(buffer.pushN(block), 4);
+    EXPECT_EQ(buffer.size(), 4);
+    EXPECT_EQ(buffer.pushN(block), 0);
+}
+
+TEST(RingBufferTests, PopNCopiesAcrossWrap)
+{
+    SHAMS::RingBuffer<int> buffer(5);
+    const int first[] = {1, 2, 3};
+    const int second[] = {4, 5, 6, 7};
+    int out[5] = {};
+
+    ASSERT_EQ(buffer.pushN(first), 3);
+    ASSERT_EQ(buffer.popN(std::span(out, 2)), 2);
+    ASSERT_EQ(buffer.pushN(second), 4);
+
+    ASSERT_EQ(buffer.popN(out), 5);
+    EXPECT_EQ(out[0], 3);
+    EXPECT_EQ(out[1], 4);
+    EXPECT_EQ(out[2], 5);
+    EXPECT_EQ(out[3], 6);
+    EXPECT_EQ(out[4], 7);
+    EXPECT_EQ(buffer.size(), 0);
+}
+
+TEST(RingBufferTests, PeekNLeavesItemsInBuffer)
+{
+    SHAMS::RingBuffer<std::string> buffer(3);
+    const std::string block[] = {"a", "b"};
+    std::string out[3];
+
+    ASSERT_EQ(buffer.pushN(block), 2);
+    EXPECT_EQ(buffer.peekN(out), 2);
+    EXPECT_EQ(out[0], "a");
+    EXPECT_EQ(out[1], "b");
+    EXPECT_EQ(buffer.size(), 2);
+}
+
+TEST(RingBufferTests, ReserveAndCommitWriteInPlace)
+{
+    SHAMS::RingBuffer<int> buffer(4);
+    int item = 0;
+
+    auto slots = buffer.reserve();
+    ASSERT_EQ(slots.size(), 4);
+    slots[0] = 10;
+    slots[1] = 20;
+    EXPECT_EQ(buffer.size(), 0);
+
+    buffer.commit(2);
+    EXPECT_EQ(buffer.size(), 2);
+    EXPECT_TRUE(buffer.pop(item));
+    EXPECT_EQ(item, 10);
+}
+
+TEST(RingBufferTests, ReserveStopsAtEndOfStorage)
+{
+    SHAMS::RingBuffer<int> buffer(4);
+    const int block[] = {1, 2, 3};
+    int out[2] = {};
+
+    buffer.pushN(block);
+    buffer.popN(out);
+
+    EXPECT_EQ(buffer.reserve().size(), 1);
+    EXPECT_THROW(buffer.commit(2), std::out_of_range);
+}
+
+TEST(RingBufferTests, PeekAndReleaseReadInPlace)
+{
+    SHAMS::RingBuffer<int> buffer(4);
+    const int block[] = {1, 2, 3};
+
+    buffer.pushN(block);
+
+    auto items = buffer.peek();
+    ASSERT_EQ(items.size(), 3);
+    EXPECT_EQ(items[0], 1);
+    EXPECT_EQ(items[2], 3);
+
+    buffer.release(2);
+    EXPECT_EQ(buffer.size(), 1);
+    EXPECT_EQ(buffer.peek()[0], 3);
+    EXPECT_THROW(buffer.release(2), std::out_of_range);
+}
+
+TEST(RingBufferTests, PopForTimesOutWhenEmpty)
+{
+    SHAMS::RingBuffer<int> buffer(2);
+    int item = 0;
+
+    EXPECT_FALSE(buffer.popFor(item, std::chrono::milliseconds(5)));
+}
+
+TEST(RingBufferTests, PushForTimesOutWhenFull)
+{
+    SHAMS::RingBuffer<int> buffer(1);
+
+    ASSERT_TRUE(buffer.push(1));
+    EXPECT_FALSE(buffer.pushFor(2, std::chrono::milliseconds(5)));
+    EXPECT_EQ(buffer.size(), 1);
+}
+
+TEST(RingBufferTests, PopWaitWakesOnPush)
+{
+    SHAMS::RingBuffer<int> buffer(2);
+    int item = 0;
+
+    std::thread producer([&buffer]()
+                         {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        buffer.push(42); });
+
+    buffer.popWait(item);
+    producer.join();
+    EXPECT_EQ(item, 42);
+}
+
+TEST(RingBufferTests, PushWaitWakesOnPop)
+{
+    SHAMS::RingBuffer<int> buffer(1);
+    int item = 0;
+
+    ASSERT_TRUE(buffer.push(1));
+    std::thread consumer([&buffer, &item]()
+                         {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        buffer.pop(item); });
+
+    buffer.pushWait(2);
+    consumer.join();
+    EXPECT_EQ(item, 1);
+    EXPECT_TRUE(buffer.popFor(item, std::chrono::milliseconds(5)));
+    EXPECT_EQ(item, 2);
+}
+
+TEST(RingBufferTests, RoundUpToPowerOfTwoCapacity)
+{
+    SHAMS::RingBuffer<int> buffer(5, SHAMS::CapacityMode::RoundUpToPowerOfTwo);
+    EXPECT_EQ(buffer.capacity(), 8);
+}
+
+TEST(RingBufferTests, SizeTracksFillAndDrainAcrossManyLaps)
+{
+    for (uint32_t capacity : {3u, 4u})
+    {
+        SHAMS::RingBuffer<int> buffer(capacity);
+        int item = 0;
+
+        for (int lap = 0; lap < 10; lap++)
+        {
+            for (uint32_t i = 0; i < capacity; i++)
+            {
+                ASSERT_TRUE(buffer.push(lap));
+            }
+            ASSERT_FALSE(buffer.push(lap));
+            ASSERT_EQ(buffer.size(), capacity);
+            ASSERT_TRUE(buffer.pop(item));
+            ASSERT_EQ(item, lap);
+            ASSERT_EQ(buffer.size(), capacity - 1);
+            while (buffer.pop(item))
+            {
+            }
+            ASSERT_EQ(buffer.size(), 0);
+        }
+    }
+}
+
+TEST(RingBufferTests, OverwriteOldestKeepsMostRecentItems)
+{
+    SHAMS::RingBuffer<int> buffer(3, SHAMS::OverflowPolicy::OverwriteOldest);
+    int item = 0;
+
+    for (int i = 0; i < 5; i++)
+    {
+        EXPECT_TRUE(buffer.push(i));
+    }
+    EXPECT_EQ(buffer.size(), 3);
+    EXPECT_EQ(buffer.overwritten(), 2);
+
+    for (int expected = 2; expected < 5; expected++)
+    {
+        ASSERT_TRUE(buffer.pop(item));
+        EXPECT_EQ(item, expected);
+    }
+}
+
+TEST(RingBufferTests, OverwriteOldestPushNAcceptsWholeBlock)
+{
+    SHAMS::RingBuffer<int> buffer(4, SHAMS::OverflowPolicy::OverwriteOldest);
+    const int first[] = {1, 2, 3};
+    const int second[] = {4, 5, 6, 7, 8, 9};
+    int out[4] = {};
+
+    EXPECT_EQ(buffer.pushN(first), 3);
+    EXPECT_EQ(buffer.pushN(second), 6);
+    EXPECT_EQ(buffer.overwritten(), 5);
+
+    ASSERT_EQ(buffer.popN(out), 4);
+    EXPECT_EQ(out[0], 6);
+    EXPECT_EQ(out[3], 9);
+}
+
+TEST(RingBufferTests, OverwriteOldestNeverBlocksPushWait)
+{
+    SHAMS::RingBuffer<int> buffer(1, SHAMS::OverflowPolicy::OverwriteOldest);
+    int item = 0;
+
+    buffer.pushWait(1);
+    buffer.pushWait(2);
+    ASSERT_TRUE(buffer.pop(item));
+    EXPECT_EQ(item, 2);
+}
+
+TEST(RingBufferTests, OverwriteOldestRejectsWhileViewIsPeeked)
+{
+    SHAMS::RingBuffer<int> buffer(2, SHAMS::OverflowPolicy::OverwriteOldest);
+
+    buffer.push(1);
+    buffer.push(2);
+    auto items = buffer.peek();
+    EXPECT_FALSE(buffer.push(3));
+    EXPECT_EQ(items[0], 1);
+
+    buffer.release(0);
+    EXPECT_TRUE(buffer.push(3));
+    EXPECT_EQ(buffer.overwritten(), 1);
+}
+
+TEST(RingBufferTests, OverwriteOldestResumesAfterUnreleasedViewIsPopped)
+{
+    SHAMS::RingBuffer<int> buffer(2, SHAMS::OverflowPolicy::OverwriteOldest);
+    int item = 0;
+
+    buffer.push(1);
+    buffer.push(2);
+    EXPECT_EQ(buffer.peek().size(), 2);
+    EXPECT_FALSE(buffer.push(3));
+
+    // The view is never released, its items are popped instead
+    ASSERT_TRUE(buffer.pop(item));
+    EXPECT_TRUE(buffer.push(3));
+    EXPECT_FALSE(buffer.push(4));
+    ASSERT_TRUE(buffer.pop(item));
+    EXPECT_EQ(item, 2);
+
+    EXPECT_TRUE(buffer.push(4));
+    EXPECT_TRUE(buffer.push(5));
+    EXPECT_EQ(buffer.overwritten(), 1);
+    ASSERT_TRUE(buffer.pop(item));
+    EXPECT_EQ(item, 4);
+}
+
+TEST(RingBufferTests, ReleasingPeekedViewWakesOverwritingProducer)
+{
+    SHAMS::RingBuffer<int> buffer(2, SHAMS::OverflowPolicy::OverwriteOldest);
+    std::atomic<bool> pushed = false;
+
+    buffer.push(1);
+    buffer.push(2);
+    ASSERT_EQ(buffer.peek().size(), 2);
+
+    std::thread producer([&buffer, &pushed]()
+                         {
+        buffer.pushWait(3);
+        pushed = true; });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(pushed);
+
+    buffer.release(0);
+    producer.join();
+    EXPECT_TRUE(pushed);
+    EXPECT_EQ(buffer.overwritten(), 1);
+    EXPECT_EQ(buffer.pop(), 2);
+    EXPECT_EQ(buffer.pop(), 3);
+}
+
+TEST(RingBufferTests, MoveOnlyItems)
+{
+    SHAMS::RingBuffer<std::unique_ptr<int>> buffer(2);
+
+    EXPECT_TRUE(buffer.push(std::make_unique<int>(1)));
+    EXPECT_TRUE(buffer.emplace(new int(2)));
+    EXPECT_FALSE(buffer.push(std::make_unique<int>(3)));
+
+    auto first = buffer.pop();
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(**first, 1);
+
+    std::unique_ptr<int> second;
+    ASSERT_TRUE(buffer.pop(second));
+    EXPECT_EQ(*second, 2);
+    EXPECT_FALSE(buffer.pop().has_value());
+}
+
+TEST(RingBufferTests, ItemsAreDestroyedOnPopAndDestruction)
+{
+    auto tracker = std::make_shared<int>(0);
+    {
+        SHAMS::RingBuffer<std::shared_ptr<int>> buffer(4, SHAMS::OverflowPolicy::OverwriteOldest);
+        for (int i = 0; i < 6; i++)
+        {
+            buffer.push(tracker);
+        }
+        EXPECT_EQ(tracker.use_count(), 5);
+
+        buffer.pop();
+        EXPECT_EQ(tracker.use_count(), 4);
+    }
+    EXPECT_EQ(tracker.use_count(), 1);
+}
+
+TEST(RingBufferTests, TypesWithoutDefaultConstructor)
+{
+    struct Sample
+    {
+        explicit Sample(int value) : value(value) {}
+        int value;
+    };
+    SHAMS::RingBuffer<Sample> buffer(2);
+
+    EXPECT_TRUE(buffer.emplace(7));
+    auto item = buffer.pop();
+    ASSERT_TRUE(item.has_value());
+    EXPECT_EQ(item->value, 7);
+}
+
+namespace
+{
+    // Minimal fire-and-forget coroutine, runs eagerly and frees its frame on completion
+    struct DetachedTask
+    {
+        struct promise_type
+        {
+            DetachedTask get_return_object() { return {}; }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+    };
+
+    DetachedTask consumeOne(SHAMS::RingBuffer<int> &buffer, int &result)
+    {
+        result = co_await buffer.popAsync();
+    }
+
+    DetachedTask produceOne(SHAMS::RingBuffer<int> &buffer, int item, bool &done)
+    {
+        co_await buffer.pushAsync(item);
+        done = true;
+    }
+} // namespace
+
+TEST(RingBufferTests, PopAsyncCompletesImmediatelyWhenItemIsAvailable)
+{
+    SHAMS::RingBuffer<int> buffer(2);
+    int result = 0;
+
+    buffer.push(3);
+    consumeOne(buffer, result);
+    EXPECT_EQ(result, 3);
+    EXPECT_EQ(buffer.size(), 0);
+}
+
+TEST(RingBufferTests, PopAsyncSuspendsUntilPush)
+{
+    SHAMS::RingBuffer<int> buffer(2);
+    int first = 0;
+    int second = 0;
+
+    consumeOne(buffer, first);
+    consumeOne(buffer, second);
+    EXPECT_EQ(first, 0);
+
+    const int block[] = {10, 20};
+    EXPECT_EQ(buffer.pushN(block), 2);
+    EXPECT_EQ(first, 10);
+    EXPECT_EQ(second, 20);
+    EXPECT_EQ(buffer.size(), 0);
+}
+
+TEST(RingBufferTests, PushAsyncSuspendsUntilPop)
+{
+    SHAMS::RingBuffer<int> buffer(1);
+    bool done = false;
+    int item = 0;
+
+    buffer.push(1);
+    produceOne(buffer, 2, done);
+    EXPECT_FALSE(done);
+
+    EXPECT_TRUE(buffer.pop(item));
+    EXPECT_EQ(item, 1);
+    EXPECT_TRUE(done);
+    EXPECT_TRUE(buffer.pop(item));
+    EXPECT_EQ(item, 2);
+}
+
+TEST(RingBufferTests, ReleasingPeekedViewResumesPushAsync)
+{
+    SHAMS::RingBuffer<int> buffer(1, SHAMS::OverflowPolicy::OverwriteOldest);
+    bool done = false;
+
+    buffer.push(1);
+    ASSERT_EQ(buffer.peek().size(), 1);
+    produceOne(buffer, 2, done);
+    EXPECT_FALSE(done);
+
+    buffer.release(0);
+    EXPECT_TRUE(done);
+    EXPECT_EQ(buffer.pop(), 2);
+}
+
+TEST(RingBufferTests, StatsCountTrafficAndPeak)
+{
+    SHAMS::RingBuffer<int, std::mutex, SHAMS::QueueStatsCounters> buffer(2);
+    int item = 0;
+
+    buffer.push(1);
+    buffer.push(2);
+    EXPECT_FALSE(buffer.push(3));
+    buffer.pop(item);
+    buffer.pop(item);
+    EXPECT_FALSE(buffer.pop(item));
+    EXPECT_FALSE(buffer.pop().has_value());
+
+    const SHAMS::QueueStats stats = buffer.stats();
+    EXPECT_EQ(stats.pushes, 2);
+    EXPECT_EQ(stats.pops, 2);
+    EXPECT_EQ(stats.rejectedPushes, 1);
+    EXPECT_EQ(stats.failedPops, 2);
+    EXPECT_EQ(stats.peakSize, 2);
+    EXPECT_EQ(stats.contendedLocks, 0);
+}
+
+TEST(RingBufferTests, StatsCountBlockOperations)
+{
+    SHAMS::RingBuffer<int, std::mutex, SHAMS::QueueStatsCounters> buffer(4);
+    const int block[] = {1, 2, 3, 4, 5, 6};
+    int out[6] = {};
+
+    EXPECT_EQ(buffer.pushN(block), 4);
+    EXPECT_EQ(buffer.popN(out), 4);
+    EXPECT_EQ(buffer.popN(out), 0);
+
+    const SHAMS::QueueStats stats = buffer.stats();
+    EXPECT_EQ(stats.pushes, 4);
+    EXPECT_EQ(stats.pops, 4);
+    EXPECT_EQ(stats.rejectedPushes, 2);
+    EXPECT_EQ(stats.failedPops, 1);
+    EXPECT_EQ(stats.peakSize, 4);
+}
+
+TEST(RingBufferTests, StatsCountOverwrittenBlockAsPushed)
+{
+    SHAMS::RingBuffer<int, std::mutex, SHAMS::QueueStatsCounters> buffer(4, SHAMS::OverflowPolicy::OverwriteOldest);
+    const int block[] = {1, 2, 3, 4, 5, 6};
+
+    EXPECT_EQ(buffer.pushN(block), 6);
+    EXPECT_EQ(buffer.overwritten(), 2);
+
+    const SHAMS::QueueStats stats = buffer.stats();
+    EXPECT_EQ(stats.pushes, 6);
+    EXPECT_EQ(stats.rejectedPushes, 0);
+    EXPECT_EQ(stats.peakSize, 4);
+}
+
+TEST(RingBufferTests, StatsAreDisabledByDefault)
+{
+    SHAMS::RingBuffer<int> buffer(2);
+
+    buffer.push(1);
+    buffer.pop();
+
+    EXPECT_EQ(buffer.stats().pushes, 0);
+    EXPECT_EQ(buffer.stats().pops, 0);
+}
+
+TEST(RingBufferTests, NullLockBufferForSingleThread)
+{
+    // No condition variables are kept for a buffer nothing can wait on
+    static_assert(sizeof(SHAMS::RingBuffer<int, SHAMS::NullLock>) < sizeof(SHAMS::RingBuffer<int, SHAMS::SpinLock>));
+    SHAMS::RingBuffer<int, SHAMS::NullLock> buffer(2);
+    const int block[] = {1, 2, 3};
+
+    EXPECT_EQ(buffer.pushN(block), 2);
+    EXPECT_EQ(buffer.pop(), 1);
+    EXPECT_EQ(buffer.pop(), 2);
+    EXPECT_FALSE(buffer.pop().has_value());
+}
+
+TEST(RingBufferTests, SpinLockBufferWaitsAcrossThreads)
+{
+    SHAMS::RingBuffer<int, SHAMS::SpinLock> buffer(1);
+    int item = 0;
+
+    std::thread producer([&buffer]()
+                         {
+        for (int i = 1; i <= 100; i++)
+        {
+            buffer.pushWait(i);
+        } });
+
+    int sum = 0;
+    for (int i = 0; i < 100; i++)
+    {
+        buffer.popWait(item);
+        sum += item;
+    }
+    producer.join();
+    EXPECT_EQ(sum, 5050);
+}
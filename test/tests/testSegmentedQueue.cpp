@@ -0,0 +1,139 @@
+#include "gtest/gtest.h"
+#include "ShamsSegmentedQueue.hpp"
+
+#include <optional>
+#include <utility>
+
+namespace
+{
+    // Cannot be copied and counts its live instances, so the queue has to move every item and destroy each exactly once
+    struct MoveOnlyCounted
+    {
+        MoveOnlyCounted(int &live, int id)
+            : live(&live),
+              id(id)
+        {
+            live++;
+        }
+
+        MoveOnlyCounted(MoveOnlyCounted &&other) noexcept
+            : live(std::exchange(other.live, nullptr)),
+              id(other.id)
+        {
+        }
+
+        MoveOnlyCounted &operator=(MoveOnlyCounted &&other) noexcept
+        {
+            this->release();
+            live = std::exchange(other.live, nullptr);
+            id = other.id;
+            return *this;
+        }
+
+        MoveOnlyCounted(const MoveOnlyCounted &) = delete;
+        MoveOnlyCounted &operator=(const MoveOnlyCounted &) = delete;
+
+        ~MoveOnlyCounted()
+        {
+            this->release();
+        }
+
+        void release()
+        {
+            if (live != nullptr)
+            {
+                (*live)--;
+                live = nullptr;
+            }
+        }
+
+        int *live;
+        int id;
+    };
+} // namespace
+
+TEST(SegmentedQueueTests, CanCreateQueue)
+{
+    SHAMS::SegmentedQueue<int> queue(8);
+    EXPECT_EQ(queue.size(), 0);
+    EXPECT_EQ(queue.segments(), 0);
+    EXPECT_THROW(SHAMS::SegmentedQueue<int>(0), std::invalid_argument);
+}
+
+TEST(SegmentedQueueTests, GrowsPastOneSegmentInOrder)
+{
+    SHAMS::SegmentedQueue<int> queue(4);
+    int item = 0;
+
+    for (int i = 0; i < 10; i++)
+    {
+        ASSERT_TRUE(queue.push(i));
+    }
+    EXPECT_EQ(queue.size(), 10);
+    EXPECT_EQ(queue.segments(), 3);
+
+    for (int i = 0; i < 10; i++)
+    {
+        ASSERT_TRUE(queue.pop(item));
+        ASSERT_EQ(item, i);
+    }
+    EXPECT_FALSE(queue.pop(item));
+}
+
+TEST(SegmentedQueueTests, DrainedSegmentsArePooledThenFreed)
+{
+    SHAMS::SegmentedQueue<int> queue(2, 1);
+
+    for (int i = 0; i < 8; i++)
+    {
+        queue.push(i);
+    }
+    EXPECT_EQ(queue.segments(), 4);
+
+    while (queue.pop().has_value())
+    {
+    }
+    // One segment stays linked, one is pooled and the rest are freed
+    EXPECT_EQ(queue.segments(), 2);
+
+    for (int i = 0; i < 4; i++)
+    {
+        queue.push(i);
+    }
+    EXPECT_EQ(queue.segments(), 2);
+}
+
+TEST(SegmentedQueueTests, SteadyStateReusesOneSegment)
+{
+    SHAMS::SegmentedQueue<int> queue(4);
+    int item = 0;
+
+    for (int i = 0; i < 100; i++)
+    {
+        queue.push(i);
+        ASSERT_TRUE(queue.pop(item));
+        ASSERT_EQ(item, i);
+    }
+    EXPECT_EQ(queue.segments(), 1);
+}
+
+TEST(SegmentedQueueTests, MoveOnlyItemsAreDestroyed)
+{
+    int live = 0;
+    {
+        SHAMS::SegmentedQueue<MoveOnlyCounted> queue(2);
+        for (int i = 0; i < 5; i++)
+        {
+            queue.emplace(live, i);
+        }
+        queue.push(MoveOnlyCounted(live, 5));
+        EXPECT_EQ(live, 6);
+
+        std::optional<MoveOnlyCounted> first = queue.pop();
+        ASSERT_TRUE(first.has_value());
+        EXPECT_EQ(first->id, 0);
+        first.reset();
+        EXPECT_EQ(live, 5);
+    }
+    EXPECT_EQ(live, 0);
+}
@@ -0,0 +1,158 @@
+#include "gtest/gtest.h"
+#include "ShamsSharedMemoryRingBuffer.hpp"
+
+#include <chrono>
+#include <csignal>
+#include <string>
+#include <thread>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+    std::string uniqueName(const char *suffix)
+    {
+        return "/shams_test_" + std::to_string(getpid()) + "_" + suffix;
+    }
+
+    // Kills and reaps a forked child unless the test already waited for it, so a failed
+    // assertion in the parent never leaves the child spinning
+    struct ChildProcess
+    {
+        explicit ChildProcess(pid_t pid)
+            : pid(pid)
+        {
+        }
+
+        ~ChildProcess()
+        {
+            if (pid > 0)
+            {
+                kill(pid, SIGKILL);
+                waitpid(pid, nullptr, 0);
+            }
+        }
+
+        int wait()
+        {
+            int status = 0;
+            waitpid(pid, &status, 0);
+            pid = 0;
+            return status;
+        }
+
+        pid_t pid;
+    };
+} // namespace
+
+TEST(SharedMemoryRingBufferTests, CanCreateAndAttach)
+{
+    const auto name = uniqueName("attach");
+    SHAMS::SharedMemoryRingBuffer<int> producer(name, 8);
+    SHAMS::SharedMemoryRingBuffer<int> consumer(name);
+    int item = 0;
+
+    EXPECT_EQ(consumer.capacity(), 8);
+    EXPECT_TRUE(producer.push(5));
+    EXPECT_EQ(consumer.size(), 1);
+    EXPECT_TRUE(consumer.pop(item));
+    EXPECT_EQ(item, 5);
+    EXPECT_FALSE(consumer.pop(item));
+}
+
+TEST(SharedMemoryRingBufferTests, PushFailsWhenFull)
+{
+    SHAMS::SharedMemoryRingBuffer<int> buffer(uniqueName("full"), 2);
+
+    EXPECT_TRUE(buffer.push(1));
+    EXPECT_TRUE(buffer.push(2));
+    EXPECT_FALSE(buffer.push(3));
+}
+
+TEST(SharedMemoryRingBufferTests, AttachRejectsMissingOrMismatchedSegment)
+{
+    const auto name = uniqueName("mismatch");
+    EXPECT_THROW(SHAMS::SharedMemoryRingBuffer<int>{name}, std::runtime_error);
+
+    SHAMS::SharedMemoryRingBuffer<int> buffer(name, 4);
+    EXPECT_THROW(SHAMS::SharedMemoryRingBuffer<double>{name}, std::runtime_error);
+    EXPECT_THROW(SHAMS::SharedMemoryRingBuffer<int>(name, 4), std::runtime_error);
+}
+
+TEST(SharedMemoryRingBufferTests, AttachToUsedSegment)
+{
+    const auto name = uniqueName("used");
+    SHAMS::SharedMemoryRingBuffer<int> owner(name, 4);
+    int item = 0;
+
+    for (int i = 0; i < 3; i++)
+    {
+        ASSERT_TRUE(owner.push(i));
+        ASSERT_TRUE(owner.pop(item));
+    }
+    SHAMS::SharedMemoryRingBuffer<int> consumer(name);
+    EXPECT_FALSE(consumer.pop(item));
+
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT_TRUE(owner.push(10 + i));
+    }
+    SHAMS::SharedMemoryRingBuffer<int> producer(name);
+    EXPECT_FALSE(producer.push(99));
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT_TRUE(consumer.pop(item));
+        EXPECT_EQ(item, 10 + i);
+    }
+    EXPECT_FALSE(consumer.pop(item));
+}
+
+TEST(SharedMemoryRingBufferTests, TwoProcessRoundTrip)
+{
+    constexpr uint64_t roundTrips = 10000;
+    const auto pingName = uniqueName("ping");
+    const auto pongName = uniqueName("pong");
+    SHAMS::SharedMemoryRingBuffer<uint64_t> ping(pingName, 16);
+    SHAMS::SharedMemoryRingBuffer<uint64_t> pong(pongName, 16);
+
+    const pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0)
+    {
+        // Echo every item back; _exit so the child never runs the parent's test teardown
+        SHAMS::SharedMemoryRingBuffer<uint64_t> requests(pingName);
+        SHAMS::SharedMemoryRingBuffer<uint64_t> replies(pongName);
+        uint64_t item = 0;
+        for (uint64_t i = 0; i < roundTrips; i++)
+        {
+            while (!requests.pop(item))
+            {
+                std::this_thread::yield();
+            }
+            while (!replies.push(item + 1))
+            {
+                std::this_thread::yield();
+            }
+        }
+        _exit(0);
+    }
+    ChildProcess child(pid);
+
+    uint64_t reply = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < roundTrips; i++)
+    {
+        ASSERT_TRUE(ping.push(i));
+        while (!pong.pop(reply))
+        {
+            std::this_thread::yield();
+        }
+        ASSERT_EQ(reply, i + 1);
+    }
+    const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+    const int status = child.wait();
+    EXPECT_TRUE(WIFEXITED(status) and WEXITSTATUS(status) == 0);
+    RecordProperty("MeanRoundTripMicroseconds", std::to_string(elapsed.count() / roundTrips));
+}
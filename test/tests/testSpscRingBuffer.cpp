@@ -0,0 +1,89 @@
+#include "gtest/gtest.h"
+#include "ShamsSpscRingBuffer.hpp"
+
+#include <thread>
+
+TEST(SpscRingBufferTests, CanCreateBuffer)
+{
+    auto buffer = SHAMS::SpscRingBuffer<int>(10);
+    EXPECT_EQ(buffer.capacity(), 10);
+    EXPECT_EQ(buffer.size(), 0);
+}
+
+TEST(SpscRingBufferTests, PushFailsWhenFull)
+{
+    SHAMS::SpscRingBuffer<int> buffer(2);
+
+    EXPECT_TRUE(buffer.push(1));
+    EXPECT_TRUE(buffer.push(2));
+    EXPECT_FALSE(buffer.push(3));
+    EXPECT_EQ(buffer.size(), 2);
+}
+
+TEST(SpscRingBufferTests, PopReturnsItemsInOrderAcrossWrap)
+{
+    SHAMS::SpscRingBuffer<int> buffer(3);
+    int item = 0;
+
+    for (int i = 0; i < 10; i++)
+    {
+        ASSERT_TRUE(buffer.push(i));
+        ASSERT_TRUE(buffer.pop(item));
+        ASSERT_EQ(item, i);
+    }
+    EXPECT_FALSE(buffer.pop(item));
+}
+
+TEST(SpscRingBufferTests, StatsCountTrafficAndPeak)
+{
+    SHAMS::SpscRingBuffer<int, SHAMS::QueueStatsCounters> buffer(2);
+    int item = 0;
+
+    buffer.push(1);
+    buffer.push(2);
+    EXPECT_FALSE(buffer.push(3));
+    buffer.pop(item);
+    buffer.pop(item);
+    EXPECT_FALSE(buffer.pop(item));
+
+    const SHAMS::QueueStats stats = buffer.stats();
+    EXPECT_EQ(stats.pushes, 2);
+    EXPECT_EQ(stats.pops, 2);
+    EXPECT_EQ(stats.rejectedPushes, 1);
+    EXPECT_EQ(stats.failedPops, 1);
+    EXPECT_EQ(stats.peakSize, 2);
+    EXPECT_EQ(stats.contendedLocks, 0);
+}
+
+TEST(SpscRingBufferTests, ProducerAndConsumerThreads)
+{
+    constexpr int itemCount = 100000;
+    SHAMS::SpscRingBuffer<int> buffer(64);
+
+    std::thread producer([&buffer]()
+                         {
+        for (int i = 0; i < itemCount; i++)
+        {
+            while (!buffer.push(i))
+            {
+                std::this_thread::yield();
+            }
+        } });
+
+    int expected = 0;
+    int item = 0;
+    while (expected < itemCount)
+    {
+        if (buffer.pop(item))
+        {
+            ASSERT_EQ(item, expected);
+            expected++;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_EQ(buffer.size(), 0);
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <ShamsStaticBuffer.hpp>
+#include <ShamsStaticDictionary.hpp>
+#include <ShamsStaticString.hpp>
+
+#include <random>
+#include <string_view>
+#include <unordered_map>
+
+TEST(StaticDictionary, InsertRetrieveRemove)
+{
+    SHAMS::StaticDictionary<int, int, 4> dict;
+
+    ASSERT_TRUE(dict.insert(1, 10));
+    ASSERT_TRUE(dict.insert(2, 20));
+    ASSERT_FALSE(dict.insert(1, 30));
+
+    ASSERT_EQ(dict[1], 10);
+    ASSERT_TRUE(dict.remove(1));
+    ASSERT_FALSE(dict.contains(1));
+    ASSERT_THROW(dict[1], std::out_of_range);
+    ASSERT_EQ(dict.size(), 1);
+    ASSERT_EQ(dict.capacity(), 4);
+}
+
+TEST(StaticDictionary, InsertFailsWhenFull)
+{
+    SHAMS::StaticDictionary<int, int, 2> dict;
+
+    ASSERT_TRUE(dict.insert(1, 10));
+    ASSERT_TRUE(dict.insert(2, 20));
+    ASSERT_FALSE(dict.insert(3, 30));
+}
+
+TEST(StaticDictionary, StaticStringKeysWithTransparentLookup)
+{
+    SHAMS::StaticDictionary<SHAMS::StaticString<16>, int, 8> dict;
+
+    ASSERT_TRUE(dict.insert(SHAMS::StaticString<16>("speed"), 1));
+    ASSERT_TRUE(dict.insert(SHAMS::StaticString<16>("torque"), 2));
+
+    ASSERT_TRUE(dict.contains(std::string_view("speed")));
+    ASSERT_EQ(dict["torque"], 2);
+    ASSERT_FALSE(dict.contains("power"));
+    ASSERT_TRUE(dict.remove("speed"));
+    ASSERT_FALSE(dict.contains(SHAMS::StaticString<16>("speed")));
+}
+
+TEST(StaticDictionary, CopiesAndNestsInStaticContainers)
+{
+    SHAMS::StaticDictionary<int, int, 4> dict;
+    dict.insert(1, 10);
+
+    SHAMS::StaticBuffer<SHAMS::StaticDictionary<int, int, 4>, 2> buffer;
+    ASSERT_TRUE(buffer.insert(dict));
+    dict.insert(2, 20);
+
+    auto &stored = *buffer.begin();
+    ASSERT_EQ(stored.size(), 1);
+    ASSERT_EQ(stored[1], 10);
+    ASSERT_FALSE(stored.contains(2));
+}
+
+TEST(StaticDictionary, MatchesReferenceMapUnderRandomOperations)
+{
+    constexpr uint32_t k_capacity = 300;
+    SHAMS::StaticDictionary<uint32_t, uint32_t, k_capacity> dict;
+    std::unordered_map<uint32_t, uint32_t> reference;
+    std::mt19937 random(7);
+
+    for (uint32_t i = 0; i < 50000; i++)
+    {
+        const uint32_t key = random() % 600;
+        if (random() % 2 == 0)
+        {
+            const bool expected = reference.size() < k_capacity and !reference.contains(key);
+            ASSERT_EQ(dict.insert(key, i), expected);
+            if (expected)
+            {
+                reference[key] = i;
+            }
+        }
+        else
+        {
+            ASSERT_EQ(dict.remove(key), reference.erase(key) == 1);
+        }
+    }
+    ASSERT_EQ(dict.size(), reference.size());
+    for (const auto &[key, value] : reference)
+    {
+        ASSERT_EQ(dict[key], value);
+    }
+}
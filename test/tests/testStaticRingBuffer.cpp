@@ -0,0 +1,127 @@
+#include "gtest/gtest.h"
+#include "ShamsStaticRingBuffer.hpp"
+
+#include <memory>
+#include <mutex>
+
+TEST(StaticRingBufferTests, CanCreateBuffer)
+{
+    SHAMS::RingBuffer<int, 10> buffer;
+    EXPECT_EQ(buffer.capacity(), 10);
+    EXPECT_EQ(buffer.size(), 0);
+}
+
+TEST(StaticRingBufferTests, PushFailsWhenFull)
+{
+    SHAMS::RingBuffer<int, 3> buffer;
+
+    EXPECT_TRUE(buffer.push(1));
+    EXPECT_TRUE(buffer.push(2));
+    EXPECT_TRUE(buffer.push(3));
+    EXPECT_FALSE(buffer.push(4));
+    EXPECT_EQ(buffer.size(), 3);
+}
+
+TEST(StaticRingBufferTests, PopReturnsItemsInOrderAcrossWrap)
+{
+    SHAMS::RingBuffer<int, 3> buffer;
+    int item = 0;
+
+    for (int i = 0; i < 20; i++)
+    {
+        ASSERT_TRUE(buffer.push(i));
+        ASSERT_TRUE(buffer.push(i + 100));
+        ASSERT_TRUE(buffer.pop(item));
+        ASSERT_EQ(item, i);
+        ASSERT_TRUE(buffer.pop(item));
+        ASSERT_EQ(item, i + 100);
+    }
+    EXPECT_FALSE(buffer.pop(item));
+}
+
+TEST(StaticRingBufferTests, PowerOfTwoCapacityFillsAndDrains)
+{
+    SHAMS::RingBuffer<int, 4> buffer;
+    int item = 0;
+
+    for (int lap = 0; lap < 5; lap++)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            ASSERT_TRUE(buffer.push(i));
+        }
+        ASSERT_FALSE(buffer.push(4));
+        ASSERT_EQ(buffer.size(), 4);
+        for (int i = 0; i < 4; i++)
+        {
+            ASSERT_TRUE(buffer.pop(item));
+            ASSERT_EQ(item, i);
+        }
+        ASSERT_EQ(buffer.size(), 0);
+    }
+}
+
+TEST(StaticRingBufferTests, MoveOnlyItems)
+{
+    SHAMS::RingBuffer<std::unique_ptr<int>, 2> buffer;
+
+    EXPECT_TRUE(buffer.push(std::make_unique<int>(1)));
+    EXPECT_TRUE(buffer.emplace(new int(2)));
+
+    auto first = buffer.pop();
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(**first, 1);
+
+    std::unique_ptr<int> second;
+    ASSERT_TRUE(buffer.pop(second));
+    EXPECT_EQ(*second, 2);
+    EXPECT_FALSE(buffer.pop().has_value());
+}
+
+TEST(StaticRingBufferTests, ItemsAreDestroyedOnPopAndDestruction)
+{
+    auto tracker = std::make_shared<int>(0);
+    {
+        SHAMS::RingBuffer<std::shared_ptr<int>, 3> buffer;
+        buffer.push(tracker);
+        buffer.push(tracker);
+        EXPECT_EQ(tracker.use_count(), 3);
+
+        buffer.pop();
+        EXPECT_EQ(tracker.use_count(), 2);
+    }
+    EXPECT_EQ(tracker.use_count(), 1);
+}
+
+TEST(StaticRingBufferTests, StatsCountTrafficAndPeak)
+{
+    SHAMS::RingBuffer<int, 3, std::mutex, SHAMS::QueueStatsCounters> buffer;
+
+    buffer.push(1);
+    buffer.push(2);
+    buffer.pop();
+    buffer.push(3);
+    buffer.push(4);
+    EXPECT_FALSE(buffer.push(5));
+    while (buffer.pop().has_value())
+    {
+    }
+
+    const SHAMS::QueueStats stats = buffer.stats();
+    EXPECT_EQ(stats.pushes, 4);
+    EXPECT_EQ(stats.pops, 4);
+    EXPECT_EQ(stats.rejectedPushes, 1);
+    EXPECT_EQ(stats.failedPops, 1);
+    EXPECT_EQ(stats.peakSize, 3);
+}
+
+TEST(StaticRingBufferTests, NullLockBufferForSingleThread)
+{
+    SHAMS::RingBuffer<int, 2, SHAMS::NullLock> buffer;
+
+    EXPECT_TRUE(buffer.push(1));
+    EXPECT_TRUE(buffer.push(2));
+    EXPECT_FALSE(buffer.push(3));
+    EXPECT_EQ(buffer.pop(), 1);
+    EXPECT_EQ(buffer.size(), 1);
+}